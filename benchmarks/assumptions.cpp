@@ -0,0 +1,166 @@
+/**
+ * Dilbert -- a patch for Peano.
+ *
+ * Benchmark of assertions as optimiser assumptions (DILBERT_ASSUME_ASSERTIONS).
+ * It times the unchecked variants of a few linear algebra and grid kernels
+ * whose invariants are written down as assertions. Build it twice within a
+ * patched Peano installation and compare the unchecked timings:
+ *
+ *   g++ -std=c++11 -O3 -march=native -I. -DDim2 \
+ *     dilbert/benchmarks/assumptions.cpp <Peano's tarch and peano objects> -o plain
+ *   g++ -std=c++11 -O3 -march=native -I. -DDim2 -DDILBERT_ASSUME_ASSERTIONS \
+ *     dilbert/benchmarks/assumptions.cpp <Peano's tarch and peano objects> -o assume
+ *
+ * The checked variants are timed, too, with the assertions switched off,
+ * i.e. they show the cost of the switched off assertions.
+ **/
+
+#include "tarch/Assertions.h"
+#include "peano/peano.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+
+namespace {
+  /**
+   * Patches of the grid kernels have PatchSize^2 cells.
+   */
+  constexpr int PatchSize = 16;
+
+
+  /**
+   * y += alpha*x as in tarch::la. Vectors are padded to multiples of four
+   * entries, i.e. the vectorised loop needs neither a remainder loop nor a
+   * check for n<=0.
+   */
+  template <bool Checked>
+  void axpy(double alpha, const double* x, double* y, int n) {
+    DILBERT_ASSERTION_VARIANT(Checked);
+    assertion1( n>0, n );
+    assertion1( n%4==0, n );
+    for (int i=0; i<n; i++) {
+      y[i] += alpha*x[i];
+    }
+  }
+
+
+  /**
+   * Dense matrix-vector product y=Ax with a row-major (rows x columns)
+   * matrix as in tarch::la.
+   */
+  template <bool Checked>
+  void multiply(const double* A, const double* x, double* y, int rows, int columns) {
+    DILBERT_ASSERTION_VARIANT(Checked);
+    assertion1( rows>0, rows );
+    assertion1( columns>0, columns );
+    assertion1( columns%4==0, columns );
+    for (int row=0; row<rows; row++) {
+      double result = 0.0;
+      for (int column=0; column<columns; column++) {
+        result += A[row*columns+column] * x[column];
+      }
+      y[row] = result;
+    }
+  }
+
+
+  /**
+   * Cell-wise update of a patch which derives the cell's position from its
+   * linearised index. The assertion on the index turns the signed divisions
+   * by PatchSize into plain shifts.
+   */
+  template <bool Checked>
+  void updateCells(const int* cells, int numberOfCells, const double* in, double* out, double h) {
+    DILBERT_ASSERTION_VARIANT(Checked);
+    for (int i=0; i<numberOfCells; i++) {
+      const int cell = cells[i];
+      assertion2( cell>=0 && cell<PatchSize*PatchSize, cell, i );
+      const int x = cell % PatchSize;
+      const int y = cell / PatchSize;
+      out[cell] = in[cell] + h * (x + 0.5) * (y + 0.5);
+    }
+  }
+
+
+  /**
+   * Five-point stencil on a patch with a halo of one cell, i.e.
+   * (size+2)^2 entries.
+   */
+  template <bool Checked>
+  void applyStencil(const double* in, double* out, int size, double h) {
+    DILBERT_ASSERTION_VARIANT(Checked);
+    assertion1( size>0, size );
+    assertion1( size%4==0, size );
+    const int width = size+2;
+    for (int y=1; y<=size; y++) {
+      for (int x=1; x<=size; x++) {
+        const int i = y*width+x;
+        out[i] = (4.0*in[i] - in[i-1] - in[i+1] - in[i-width] - in[i+width]) / (h*h);
+      }
+    }
+  }
+
+
+  /**
+   * Runs the kernel repetitions times and returns the best of five runs in
+   * nanoseconds per call.
+   */
+  template <class Kernel>
+  double measure(Kernel kernel, int repetitions) {
+    double best = 1e300;
+    for (int run=0; run<5; run++) {
+      const auto start = std::chrono::steady_clock::now();
+      for (int i=0; i<repetitions; i++) {
+        kernel();
+      }
+      const double time = std::chrono::duration<double,std::nano>(std::chrono::steady_clock::now()-start).count() / repetitions;
+      best = time<best ? time : best;
+    }
+    return best;
+  }
+
+
+  template <class Checked, class Unchecked>
+  void report(const char* name, Checked checked, Unchecked unchecked, int repetitions) {
+    const double checkedTime   = measure(checked, repetitions);
+    const double uncheckedTime = measure(unchecked, repetitions);
+    std::printf( "%-34s %10.1f %10.1f\n", name, checkedTime, uncheckedTime );
+  }
+}
+
+
+int main(int argc, char** argv) {
+  peano::initParallelEnvironment(&argc,&argv);
+
+  #ifdef DILBERT_ASSUME_ASSERTIONS
+  std::printf( "Unchecked variants use the assertions as assumptions\n\n" );
+  #else
+  std::printf( "Unchecked variants ignore the assertions\n\n" );
+  #endif
+  std::printf( "%-34s %10s %10s\n", "kernel [ns per call]", "checked", "unchecked" );
+
+  // Sizes are read from the command line such that the compiler cannot fold them
+  const int n    = argc>1 ? std::atoi(argv[1]) : 36;
+  const int size = argc>2 ? std::atoi(argv[2]) : PatchSize;
+
+  std::vector<double> x(n, 1.0), y(n, 0.0), A(n*n, 0.5);
+  volatile double alpha = 1e-8;
+  report( "la: axpy", [&]() { axpy<true>(alpha, x.data(), y.data(), n); }, [&]() { axpy<false>(alpha, x.data(), y.data(), n); }, 100000000/n );
+  report( "la: matrix-vector", [&]() { multiply<true>(A.data(), x.data(), y.data(), n, n); }, [&]() { multiply<false>(A.data(), x.data(), y.data(), n, n); }, 100000000/(n*n) );
+
+  std::vector<int> cells(PatchSize*PatchSize);
+  for (int i=0; i<PatchSize*PatchSize; i++) {
+    cells[i] = (i*7) % (PatchSize*PatchSize);
+  }
+  std::vector<double> cellsIn(PatchSize*PatchSize, 1.0), cellsOut(PatchSize*PatchSize, 0.0);
+  report( "grid: cell update", [&]() { updateCells<true>(cells.data(), PatchSize*PatchSize, cellsIn.data(), cellsOut.data(), 0.1); }, [&]() { updateCells<false>(cells.data(), PatchSize*PatchSize, cellsIn.data(), cellsOut.data(), 0.1); }, 1000000 );
+
+  std::vector<double> in((size+2)*(size+2), 1.0), out((size+2)*(size+2), 0.0);
+  report( "grid: five-point stencil", [&]() { applyStencil<true>(in.data(), out.data(), size, 0.1); }, [&]() { applyStencil<false>(in.data(), out.data(), size, 0.1); }, 100000000/(size*size) );
+
+  peano::shutdownParallelEnvironment();
+  return 0;
+}
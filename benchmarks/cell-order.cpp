@@ -0,0 +1,242 @@
+/**
+ * Dilbert -- a patch for Peano.
+ *
+ * Locality benchmark of the curves of
+ * peano::grid::aspects::CellLocalSpaceFillingCurve (peano, hilbert and
+ * morton). Build it once per dimension within a patched Peano installation,
+ * e.g.
+ *
+ *   g++ -std=c++11 -O3 -march=native -I. -DDim2 \
+ *     dilbert/benchmarks/cell-order.cpp peano/grid/aspects/CellLocalSpaceFillingCurve.cpp -o cell-order-2d
+ *   g++ -std=c++11 -O3 -march=native -I. -DDim3 \
+ *     dilbert/benchmarks/cell-order.cpp peano/grid/aspects/CellLocalSpaceFillingCurve.cpp -o cell-order-3d
+ *
+ * and run it without arguments. Peano runs on a 3^k patch, the others on the
+ * next smaller and the next larger 2^k patch. For each curve, it reports the
+ * reuse distance of the vertices (number of distinct vertices touched
+ * between two accesses to the same vertex, i.e. the LRU stack depth a
+ * vertex cache needs) and the time per cell of a kernel which averages the
+ * 2^d vertices of each cell, once with the curve evaluated on the fly and
+ * once along a precomputed order.
+ **/
+
+#include "peano/grid/aspects/CellLocalSpaceFillingCurve.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+
+namespace {
+  using peano::grid::aspects::CellLocalSpaceFillingCurve;
+
+  struct Patch {
+    CellLocalSpaceFillingCurve::Curve curve;
+    int                               levels;
+    int                               cellsPerDimension;
+    int                               cells;
+    int                               vertices;
+  };
+
+
+  Patch createPatch(CellLocalSpaceFillingCurve::Curve curve, int levels) {
+    Patch patch;
+    patch.curve             = curve;
+    patch.levels            = levels;
+    patch.cellsPerDimension = 1;
+    for (int level=0; level<levels; level++) {
+      patch.cellsPerDimension *= CellLocalSpaceFillingCurve::getBase(curve);
+    }
+    patch.cells    = 1;
+    patch.vertices = 1;
+    for (int d=0; d<DIMENSIONS; d++) {
+      patch.cells    *= patch.cellsPerDimension;
+      patch.vertices *= patch.cellsPerDimension+1;
+    }
+    return patch;
+  }
+
+
+  int getVertex(const Patch& patch, const int* cell, int corner) {
+    int vertex = 0;
+    for (int d=DIMENSIONS-1; d>=0; d--) {
+      vertex = vertex*(patch.cellsPerDimension+1) + cell[d] + ((corner>>d) & 1);
+    }
+    return vertex;
+  }
+
+
+  /**
+   * Round trip of all indices, and consecutive cells have to share a face
+   * for Peano and Hilbert.
+   */
+  int validate(const Patch& patch) {
+    int errors = 0;
+    int previous[DIMENSIONS] = {0};
+    for (int index=0; index<patch.cells; index++) {
+      int cell[DIMENSIONS];
+      CellLocalSpaceFillingCurve::getCoordinates(patch.curve, patch.levels, index, cell);
+      errors += CellLocalSpaceFillingCurve::getIndex(patch.curve, patch.levels, cell)!=index;
+
+      int distance = 0;
+      for (int d=0; d<DIMENSIONS; d++) {
+        errors     += cell[d]<0 || cell[d]>=patch.cellsPerDimension;
+        distance   += std::abs(cell[d]-previous[d]);
+        previous[d] = cell[d];
+      }
+      errors += index>0 && patch.curve!=CellLocalSpaceFillingCurve::Morton && distance!=1;
+    }
+    return errors;
+  }
+
+
+  /**
+   * Fenwick tree over the access times which marks the most recent access
+   * of each vertex, such that the distinct vertices since the last access
+   * are a prefix sum.
+   */
+  class AccessTimes {
+    private:
+      std::vector<int> _tree;
+
+    public:
+      AccessTimes(int size): _tree(size+1, 0) {}
+
+      void add(int time, int value) {
+        for (int i=time+1; i<static_cast<int>(_tree.size()); i+=i&-i) {
+          _tree[i] += value;
+        }
+      }
+
+      int sum(int time) const {
+        int result = 0;
+        for (int i=time+1; i>0; i-=i&-i) {
+          result += _tree[i];
+        }
+        return result;
+      }
+  };
+
+
+  /**
+   * Mean reuse distance and share of the reuses within the given distances.
+   */
+  void measureReuse(const Patch& patch, double& mean, double& withinL1, double& withinL2) {
+    const int   accesses = patch.cells * (1<<DIMENSIONS);
+    AccessTimes times(accesses);
+    std::vector<int> lastAccess(patch.vertices, -1);
+
+    long long total  = 0;
+    int       reuses = 0;
+    int       l1     = 0;
+    int       l2     = 0;
+    int       time   = 0;
+    for (int index=0; index<patch.cells; index++) {
+      int cell[DIMENSIONS];
+      CellLocalSpaceFillingCurve::getCoordinates(patch.curve, patch.levels, index, cell);
+      for (int corner=0; corner<(1<<DIMENSIONS); corner++) {
+        const int vertex = getVertex(patch, cell, corner);
+        if (lastAccess[vertex]>=0) {
+          const int distance = times.sum(time-1) - times.sum(lastAccess[vertex]);
+          total += distance;
+          reuses++;
+          l1 += distance<512;
+          l2 += distance<16384;
+          times.add(lastAccess[vertex], -1);
+        }
+        times.add(time, 1);
+        lastAccess[vertex] = time;
+        time++;
+      }
+    }
+
+    mean     = static_cast<double>(total)/reuses;
+    withinL1 = 100.0*l1/reuses;
+    withinL2 = 100.0*l2/reuses;
+  }
+
+
+  /**
+   * Averages the vertex values into the cells and returns the time per
+   * cell in nanoseconds (best of five runs).
+   */
+  double measureThroughput(const Patch& patch, const std::vector<int>* order, double& checksum) {
+    std::vector<double> vertexData(patch.vertices);
+    std::vector<double> cellData(patch.cells);
+    for (int vertex=0; vertex<patch.vertices; vertex++) {
+      vertexData[vertex] = 1.0 + 1e-3*vertex;
+    }
+
+    double best = 1e300;
+    for (int run=0; run<5; run++) {
+      const auto start = std::chrono::steady_clock::now();
+      for (int index=0; index<patch.cells; index++) {
+        int cell[DIMENSIONS];
+        if (order==NULL) {
+          CellLocalSpaceFillingCurve::getCoordinates(patch.curve, patch.levels, index, cell);
+        } else {
+          for (int d=0; d<DIMENSIONS; d++) {
+            cell[d] = (*order)[index*DIMENSIONS+d];
+          }
+        }
+        double sum = 0.0;
+        for (int corner=0; corner<(1<<DIMENSIONS); corner++) {
+          sum += vertexData[getVertex(patch, cell, corner)];
+        }
+        cellData[index] = sum / (1<<DIMENSIONS);
+      }
+      const double time = std::chrono::duration<double,std::nano>(std::chrono::steady_clock::now()-start).count() / patch.cells;
+      best = time<best ? time : best;
+      checksum += cellData[patch.cells/2];
+    }
+    return best;
+  }
+}
+
+
+int main() {
+  // the Peano patch lies between the two power-of-two ones
+  #if DIMENSIONS==2
+  const Patch patches[] = {
+    createPatch(CellLocalSpaceFillingCurve::Peano,   6),
+    createPatch(CellLocalSpaceFillingCurve::Hilbert, 9),
+    createPatch(CellLocalSpaceFillingCurve::Morton,  9),
+    createPatch(CellLocalSpaceFillingCurve::Hilbert, 10),
+    createPatch(CellLocalSpaceFillingCurve::Morton,  10)
+  };
+  #else
+  const Patch patches[] = {
+    createPatch(CellLocalSpaceFillingCurve::Peano,   4),
+    createPatch(CellLocalSpaceFillingCurve::Hilbert, 6),
+    createPatch(CellLocalSpaceFillingCurve::Morton,  6),
+    createPatch(CellLocalSpaceFillingCurve::Hilbert, 7),
+    createPatch(CellLocalSpaceFillingCurve::Morton,  7)
+  };
+  #endif
+
+  std::printf( "%d dimensions, reuse distances in vertices, times in ns per cell\n\n", DIMENSIONS );
+  std::printf( "%-8s %8s %10s %8s %8s %10s %10s\n", "curve", "cells", "mean reuse", "<512", "<16384", "on the fly", "precomputed" );
+
+  double checksum = 0.0;
+  int    errors   = 0;
+  for (const Patch& patch: patches) {
+    errors += validate(patch);
+
+    double mean, withinL1, withinL2;
+    measureReuse(patch, mean, withinL1, withinL2);
+
+    std::vector<int> order(patch.cells*DIMENSIONS);
+    for (int index=0; index<patch.cells; index++) {
+      CellLocalSpaceFillingCurve::getCoordinates(patch.curve, patch.levels, index, &order[index*DIMENSIONS]);
+    }
+    const double onTheFly    = measureThroughput(patch, NULL,   checksum);
+    const double precomputed = measureThroughput(patch, &order, checksum);
+
+    std::printf( "%-8s %8d %10.1f %7.1f%% %7.1f%% %10.2f %10.2f\n",
+      CellLocalSpaceFillingCurve::getCurveName(patch.curve), patch.cells, mean, withinL1, withinL2, onTheFly, precomputed );
+  }
+
+  std::printf( "\n%d errors (checksum %g)\n", errors, checksum );
+  return errors==0 ? 0 : 1;
+}
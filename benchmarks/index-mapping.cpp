@@ -0,0 +1,127 @@
+/**
+ * Dilbert -- a patch for Peano.
+ *
+ * Benchmark of the backends of peano::utils::indexmapping (automatic,
+ * table and arithmetic). Build it once per dimension within a patched Peano
+ * installation, e.g.
+ *
+ *   g++ -std=c++11 -O3 -march=native -I. -DDim2 \
+ *     dilbert/benchmarks/index-mapping.cpp <Peano's tarch and peano objects> -o index-mapping-2d
+ *   g++ -std=c++11 -O3 -march=native -I. -DDim3 \
+ *     dilbert/benchmarks/index-mapping.cpp <Peano's tarch and peano objects> -o index-mapping-3d
+ *
+ * and run it without arguments. Each lookup is timed with a hot L1 cache
+ * and once more after streaming through a solver-sized array, where the
+ * tables have to be reloaded.
+ **/
+
+#include "peano/utils/IndexMapping.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+
+namespace {
+  using namespace peano::utils::indexmapping;
+
+  const Backend Backends[] = { Automatic, Table, Arithmetic };
+
+  /**
+   * Some MB of patch data which a solver would touch between two grid
+   * traversal steps.
+   */
+  std::vector<double> solverData(1<<20, 1.0);
+
+  double touchSolverData() {
+    double sum = 0.0;
+    for (std::size_t i=0; i<solverData.size(); i+=8) {
+      sum += solverData[i];
+    }
+    return sum;
+  }
+
+
+  /**
+   * Delinearises and re-linearises the given values and returns the time
+   * per value in nanoseconds (best of five runs).
+   */
+  double measure(const std::vector<int>& values, int max, bool coldCache, long long& checksum) {
+    double best = 1e300;
+    for (int run=0; run<5; run++) {
+      double time = 0.0;
+      for (int block=0; block<64; block++) {
+        if (coldCache) {
+          checksum += static_cast<long long>(touchSolverData());
+        }
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i=block; i<values.size(); i+=64) {
+          int counter[DIMENSIONS];
+          dDelinearised(values[i], max, counter);
+          checksum += dLinearised(counter, max) + counter[DIMENSIONS-1];
+        }
+        time += std::chrono::duration<double,std::nano>(std::chrono::steady_clock::now()-start).count();
+      }
+      time /= values.size();
+      best = time<best ? time : best;
+    }
+    return best;
+  }
+
+
+  /**
+   * All backends have to agree with the arithmetic one.
+   */
+  int validate(int max) {
+    int errors = 0;
+    int cube   = 1;
+    for (int d=0; d<DIMENSIONS; d++) cube *= max;
+    for (Backend candidate: Backends) {
+      backend = candidate;
+      for (int value=0; value<cube; value++) {
+        int counter[DIMENSIONS];
+        int expected[DIMENSIONS];
+        dDelinearised(value, max, counter);
+        dDelinearisedArithmetic(value, max, expected);
+        for (int d=0; d<DIMENSIONS; d++) {
+          errors += counter[d]!=expected[d];
+        }
+        errors += dLinearised(counter, max)!=value;
+      }
+    }
+    return errors;
+  }
+}
+
+
+int main(int argc, char** argv) {
+  const int maxima[] = {2, 3, 4, 8, 16};
+  std::printf( "%d dimensions\n\n", DIMENSIONS );
+  std::printf( "%-10s %-10s %12s %12s\n", "cube", "backend", "hot [ns]", "cold [ns]" );
+
+  // the values are random, such that the lookups cannot be predicted
+  const unsigned int seed = argc>1 ? std::atoi(argv[1]) : 1;
+  std::srand(seed);
+  long long checksum = 0;
+  int       errors   = 0;
+  for (int max: maxima) {
+    int cube = 1;
+    for (int d=0; d<DIMENSIONS; d++) cube *= max;
+    std::vector<int> values(1<<18);
+    for (int& value: values) {
+      value = std::rand() % cube;
+    }
+
+    errors += validate(max);
+    for (Backend candidate: Backends) {
+      backend = candidate;
+      const double hot  = measure(values, max, false, checksum);
+      const double cold = measure(values, max, true,  checksum);
+      std::printf( "%2d^%-7d %-10s %12.2f %12.2f\n", max, DIMENSIONS, getBackendName(candidate), hot, cold );
+    }
+  }
+
+  std::printf( "\n%d errors (checksum %lld)\n", errors, checksum );
+  return errors==0 ? 0 : 1;
+}
@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+#
+# Prints a flight recorder file which Dilbert writes on a failing assertion
+# if DILBERT_FLIGHT_RECORDER is set, e.g.
+#
+#   ./decode-flight-recorder.py flight-rank0.bin --last 100 --thread 3
+#
+# The layout follows FlightHeader, FlightRecord and FlightEvent in
+# src/tarch/Assertions.h and src/tarch/Assertions.cpp.
+
+import argparse
+import struct
+import sys
+
+Events = ["traversal boundary", "enter cell", "leave cell", "refine", "coarsen",
+          "exchange", "user event", "assertion failure"]
+
+Header = struct.Struct("<8sIIIidQi252s")
+Counts = struct.Struct("<QQ")
+Record = struct.Struct("<QIIQ")
+
+
+def main():
+  parser = argparse.ArgumentParser(description="Print a Dilbert flight recorder file")
+  parser.add_argument("file")
+  parser.add_argument("--last", type=int, default=50, help="number of events to print (0 for all)")
+  parser.add_argument("--thread", type=int, default=None, help="print the events of this thread only")
+  arguments = parser.parse_args()
+
+  with open(arguments.file, "rb") as file:
+    data = file.read()
+
+  magic, version, threads, failingThread, rank, frequency, failureTime, line, sourceFile = Header.unpack_from(data, 0)
+  if magic.rstrip(b"\0")!=b"DILBFR1" or version!=1:
+    sys.exit("%s is no flight recorder file (version 1)" % arguments.file)
+  sourceFile = sourceFile.split(b"\0")[0].decode(errors="replace")
+  print("Assertion in file %s, line %d failed on rank %d, thread %d" % (sourceFile, line, rank, failingThread))
+
+  offset = Header.size
+  events = []
+  for _ in range(threads):
+    thread, count = Counts.unpack_from(data, offset)
+    offset += Counts.size
+    print("  thread %d recorded %d events" % (thread, count))
+    for _ in range(count):
+      time, event, level, payload = Record.unpack_from(data, offset)
+      offset += Record.size
+      if arguments.thread is None or arguments.thread==thread:
+        events.append((time, thread, event, level, payload))
+
+  events.sort()
+  if arguments.last>0:
+    events = events[-arguments.last:]
+  print()
+  print("%14s %7s  %-20s %6s  %s" % ("time [us]", "thread", "event", "level", "payload"))
+  for time, thread, event, level, payload in events:
+    name = Events[event] if event<len(Events) else "event %d" % event
+    print("%14.3f %7d  %-20s %6d  %d" % ((time - failureTime) / frequency * 1e6, thread, name, level, payload))
+
+  print()
+  print("Backtrace of the failing thread:")
+  print(data[offset:].decode(errors="replace").rstrip())
+
+
+if __name__=="__main__":
+  main()
@@ -0,0 +1,212 @@
+/**
+ * Dilbert -- a patch for Peano.
+ * This file is a Dilbert patch file.
+ **/
+
+#include "peano/grid/aspects/CellLocalSpaceFillingCurve.h"
+
+#include <cstddef>
+#include <strings.h>
+
+
+peano::grid::aspects::CellLocalSpaceFillingCurve::Curve peano::grid::aspects::CellLocalSpaceFillingCurve::curve = peano::grid::aspects::CellLocalSpaceFillingCurve::Peano;
+
+
+namespace {
+  /**
+   * The ternary digits of a Peano index run from the coarsest level to the
+   * finest one, and within a level from axis 0 to axis d-1. The digit of
+   * axis i is mirrored (2-digit) if the digits of all other axes before it
+   * sum up to an odd number. As 2-digit and digit have the same parity,
+   * the sums may be taken over the coordinate digits, too.
+   */
+  inline int mirror(int digit, int sum) {
+    // the parity follows the curve, a branch on it would be mispredicted
+    return digit + (sum & 1)*(2-2*digit);
+  }
+
+
+  void getPeanoCoordinates(int levels, int index, int* coordinates) {
+    int digits[19];
+    for (int i=levels*DIMENSIONS-1; i>=0; i--) {
+      digits[i] = index % 3;
+      index    /= 3;
+    }
+
+    int parity[DIMENSIONS] = {0};
+    int total              = 0;
+    for (int d=0; d<DIMENSIONS; d++) {
+      coordinates[d] = 0;
+    }
+    for (int i=0; i<levels*DIMENSIONS; i++) {
+      const int axis  = i % DIMENSIONS;
+      const int digit = mirror(digits[i], total-parity[axis]);
+      coordinates[axis] = coordinates[axis]*3 + digit;
+      parity[axis]     += digits[i];
+      total            += digits[i];
+    }
+  }
+
+
+  int getPeanoIndex(int levels, const int* coordinates) {
+    int digits[DIMENSIONS][19];
+    for (int d=0; d<DIMENSIONS; d++) {
+      int coordinate = coordinates[d];
+      for (int level=levels-1; level>=0; level--) {
+        digits[d][level] = coordinate % 3;
+        coordinate      /= 3;
+      }
+    }
+
+    int parity[DIMENSIONS] = {0};
+    int total              = 0;
+    int index              = 0;
+    for (int i=0; i<levels*DIMENSIONS; i++) {
+      const int axis  = i % DIMENSIONS;
+      const int level = i / DIMENSIONS;
+      const int digit = mirror(digits[axis][level], total-parity[axis]);
+      index         = index*3 + digit;
+      parity[axis] += digit;
+      total        += digit;
+    }
+    return index;
+  }
+
+
+  /**
+   * Hilbert curve after J. Skilling, Programming the Hilbert curve (AIP
+   * Conference Proceedings 707, 2004). It works on the "transposed" index,
+   * where bit b of axis i holds index bit b*d+(d-1-i), i.e. the Morton
+   * interleaving with axis 0 as the most significant one.
+   */
+  void transposeToAxes(unsigned int* x, int levels) {
+    const unsigned int n = 2u << (levels-1);
+    unsigned int t = x[DIMENSIONS-1] >> 1;
+    for (int i=DIMENSIONS-1; i>0; i--) {
+      x[i] ^= x[i-1];
+    }
+    x[0] ^= t;
+    for (unsigned int q=2; q!=n; q<<=1) {
+      const unsigned int p = q-1;
+      for (int i=DIMENSIONS-1; i>=0; i--) {
+        if (x[i] & q) {
+          x[0] ^= p;
+        } else {
+          t = (x[0] ^ x[i]) & p;
+          x[0] ^= t;
+          x[i] ^= t;
+        }
+      }
+    }
+  }
+
+
+  void axesToTranspose(unsigned int* x, int levels) {
+    const unsigned int m = 1u << (levels-1);
+    for (unsigned int q=m; q>1; q>>=1) {
+      const unsigned int p = q-1;
+      for (int i=0; i<DIMENSIONS; i++) {
+        if (x[i] & q) {
+          x[0] ^= p;
+        } else {
+          const unsigned int t = (x[0] ^ x[i]) & p;
+          x[0] ^= t;
+          x[i] ^= t;
+        }
+      }
+    }
+    for (int i=1; i<DIMENSIONS; i++) {
+      x[i] ^= x[i-1];
+    }
+    unsigned int t = 0;
+    for (unsigned int q=m; q>1; q>>=1) {
+      if (x[DIMENSIONS-1] & q) {
+        t ^= q-1;
+      }
+    }
+    for (int i=0; i<DIMENSIONS; i++) {
+      x[i] ^= t;
+    }
+  }
+
+
+  /**
+   * Distributes the index bits onto the axes, axis mostSignificant first.
+   */
+  void deinterleave(int levels, int index, unsigned int* x, bool axisZeroMostSignificant) {
+    for (int d=0; d<DIMENSIONS; d++) {
+      x[d] = 0;
+    }
+    for (int bit=0; bit<levels*DIMENSIONS; bit++) {
+      const int axis = axisZeroMostSignificant ? DIMENSIONS-1 - bit%DIMENSIONS : bit%DIMENSIONS;
+      x[axis] |= ((static_cast<unsigned int>(index) >> bit) & 1u) << (bit/DIMENSIONS);
+    }
+  }
+
+
+  int interleave(int levels, const unsigned int* x, bool axisZeroMostSignificant) {
+    unsigned int index = 0;
+    for (int bit=0; bit<levels*DIMENSIONS; bit++) {
+      const int axis = axisZeroMostSignificant ? DIMENSIONS-1 - bit%DIMENSIONS : bit%DIMENSIONS;
+      index |= ((x[axis] >> (bit/DIMENSIONS)) & 1u) << bit;
+    }
+    return static_cast<int>(index);
+  }
+}
+
+
+bool peano::grid::aspects::CellLocalSpaceFillingCurve::selectCurve(const char* name) {
+  if (name==NULL || strcasecmp(name, "peano")==0) {
+    curve = Peano;
+  } else if (strcasecmp(name, "hilbert")==0) {
+    curve = Hilbert;
+  } else if (strcasecmp(name, "morton")==0) {
+    curve = Morton;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+
+const char* peano::grid::aspects::CellLocalSpaceFillingCurve::getCurveName(Curve curve) {
+  return curve==Hilbert ? "hilbert" : curve==Morton ? "morton" : "peano";
+}
+
+
+int peano::grid::aspects::CellLocalSpaceFillingCurve::getBase(Curve curve) {
+  return curve==Peano ? 3 : 2;
+}
+
+
+void peano::grid::aspects::CellLocalSpaceFillingCurve::getCoordinates(Curve curve, int levels, int index, int* coordinates) {
+  if (curve==Peano) {
+    getPeanoCoordinates(levels, index, coordinates);
+    return;
+  }
+
+  unsigned int x[DIMENSIONS];
+  deinterleave(levels, index, x, curve==Hilbert);
+  if (curve==Hilbert && levels>0) {
+    transposeToAxes(x, levels);
+  }
+  for (int d=0; d<DIMENSIONS; d++) {
+    coordinates[d] = static_cast<int>(x[d]);
+  }
+}
+
+
+int peano::grid::aspects::CellLocalSpaceFillingCurve::getIndex(Curve curve, int levels, const int* coordinates) {
+  if (curve==Peano) {
+    return getPeanoIndex(levels, coordinates);
+  }
+
+  unsigned int x[DIMENSIONS];
+  for (int d=0; d<DIMENSIONS; d++) {
+    x[d] = static_cast<unsigned int>(coordinates[d]);
+  }
+  if (curve==Hilbert && levels>0) {
+    axesToTranspose(x, levels);
+  }
+  return interleave(levels, x, curve==Hilbert);
+}
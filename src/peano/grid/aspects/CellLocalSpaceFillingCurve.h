@@ -0,0 +1,94 @@
+/**
+ * Dilbert -- a patch for Peano.
+ * This file is a Dilbert patch file.
+ **/
+
+#ifndef _PEANO_GRID_ASPECTS_CELL_LOCAL_SPACE_FILLING_CURVE_H_
+#define _PEANO_GRID_ASPECTS_CELL_LOCAL_SPACE_FILLING_CURVE_H_
+
+#include "peano/utils/Globals.h"
+
+
+namespace peano {
+  namespace grid {
+    namespace aspects {
+      class CellLocalSpaceFillingCurve;
+    }
+  }
+}
+
+
+/**
+ * Cell-local orderings of a regular patch with base^levels cells per
+ * dimension, e.g. for solvers which store their data in 2^d-blocked
+ * patches. There are three curves:
+ *
+ * - Peano (base 3): The ordering of CellLocalPeanoCurve, i.e. a
+ *   meander through 3^d children per level. Consecutive cells share a face.
+ * - Hilbert (base 2): Consecutive cells share a face, too, but the patches
+ *   have power-of-two sizes.
+ * - Morton (base 2): The z-order, i.e. the bits of the coordinates are
+ *   interleaved. It is the cheapest to compute but jumps between the
+ *   quadrants.
+ *
+ * The curve is selected once in peano::initParallelEnvironment() via
+ *
+ *   export DILBERT_CELL_ORDER=peano|hilbert|morton
+ *
+ * and patch kernels iterate over index=0,1,... and ask for the coordinates.
+ * The option only affects kernels which use this class. Peano's grid
+ * traversal (CellLocalPeanoCurve and its vertex stacks) is not part of this
+ * patch and always follows the Peano curve. See benchmarks/cell-order.cpp
+ * for the reuse distances and throughput of the three.
+ */
+class peano::grid::aspects::CellLocalSpaceFillingCurve {
+  public:
+    enum Curve {
+      Peano = 0,
+      Hilbert,
+      Morton
+    };
+
+    /**
+     * Curve of getCoordinates() and getIndex() without curve argument.
+     */
+    static Curve curve;
+
+    /**
+     * Sets curve, NULL keeps Peano. Returns false for an unknown name.
+     */
+    static bool selectCurve(const char* name);
+
+    /**
+     * "peano", "hilbert" or "morton".
+     */
+    static const char* getCurveName(Curve curve);
+
+    /**
+     * Number of cells per dimension and level, i.e. 3 for Peano and 2 for
+     * the others.
+     */
+    static int getBase(Curve curve);
+
+    /**
+     * Coordinates (0,...,base^levels-1 per dimension) of the index-th cell
+     * along the curve. levels may be at most 31/DIMENSIONS for base 2 and
+     * 19/DIMENSIONS for base 3, such that the index fits into an int.
+     */
+    static void getCoordinates(Curve curve, int levels, int index, int* coordinates);
+
+    /**
+     * Inverse of getCoordinates().
+     */
+    static int getIndex(Curve curve, int levels, const int* coordinates);
+
+    static void getCoordinates(int levels, int index, int* coordinates) {
+      getCoordinates(curve, levels, index, coordinates);
+    }
+
+    static int getIndex(int levels, const int* coordinates) {
+      return getIndex(curve, levels, coordinates);
+    }
+};
+
+#endif
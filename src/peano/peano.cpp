@@ -21,14 +21,46 @@
 
 /* DILBERT START */
 #include "tarch/Assertions.h" // for accessing the mode storage
+#include "tarch/la/Scalar.h" // for the default tolerance
+#include "peano/utils/IndexMapping.h" // backend of the index lookups
+#include "peano/grid/aspects/CellLocalSpaceFillingCurve.h" // cell order of patches
 bool dilbert_Asserts; // Storage for the global
+bool dilbert_AssertCollect = false; // Storage for the global
+unsigned int dilbert_AssertCollectLimit = 10; // Storage for the global
+unsigned int dilbert_AssertScopes; // Storage for the global
+int dilbert_AssertCost = dilbert::assertions::Paranoid; // Storage for the global
+unsigned int dilbert_AssertSample = 1; // Storage for the global
+int dilbert_AssertStatistics = dilbert::assertions::NoStatistics; // Storage for the global
+double dilbert_AssertBudget = 0.0; // Storage for the global
+bool dilbert_AssertCollectives = false; // Storage for the global
+int dilbert_AssertAbortGrace = 0; // Storage for the global
+const char* dilbert_FlightRecorder = NULL; // Storage for the global
+int dilbert_FloatingPointTraps = 0; // Storage for the global
+double dilbert_AssertAbsoluteTolerance = tarch::la::NUMERICAL_ZERO_DIFFERENCE; // Storage for the global
+double dilbert_AssertRelativeTolerance = 0.0; // Storage for the global
+long long dilbert_AssertUlpTolerance = 0; // Storage for the global
 
 #include <cstdlib> // getenv
+#include <cstring> // strlen
+#include <fenv.h> // FE_INVALID etc.
 #include <strings.h> // strcasecmp
 bool equals(const char* a, const char* b) { return (strcasecmp (a, b) == 0); }
 /* DILBERT END */
 
 void peano::fillLookupTables() {
+  /* DILBERT START */
+  char* mapping = std::getenv("DILBERT_INDEX_MAPPING");
+  if(peano::utils::indexmapping::selectBackend(mapping)) {
+    if(mapping!=NULL) {
+      printf("Dilbert patches Peano: DILBERT_INDEX_MAPPING='%s' was given, therefore d-dimensional indices are mapped by the %s backend\n",
+        mapping, peano::utils::indexmapping::getBackendName(peano::utils::indexmapping::backend));
+    }
+  } else {
+    printf("Dilbert patches Peano: Ignoring unknown DILBERT_INDEX_MAPPING='%s' (use automatic, table or arithmetic), therefore using the %s backend\n",
+      mapping, peano::utils::indexmapping::getBackendName(peano::utils::indexmapping::backend));
+  }
+  /* DILBERT END */
+
   setupLookupTableForTwoPowI();
   setupLookupTableForThreePowI();
   setupLookupTableForFourPowI();
@@ -46,19 +78,219 @@ int peano::initParallelEnvironment(int* argc, char*** argv) {
     mode = std::getenv("MODE");
     // by default, if no environment variable is given, do no assertions.
     if(mode!=NULL) {
-      dilbert_Asserts = (equals(mode, "Debug") || equals(mode, "Asserts"));
-      printf("Dilbert patches Peano: Assertion MODE='%s' was given, therefore Asserts=%s\n",
-        mode, dilbert_Asserts ? "true" : "false");
+      dilbert_Asserts = (equals(mode, "Debug") || equals(mode, "Asserts") || equals(mode, "Collect"));
+      dilbert_AssertCollect = equals(mode, "Collect");
+      printf("Dilbert patches Peano: Assertion MODE='%s' was given, therefore Asserts=%s%s\n",
+        mode, dilbert_Asserts ? "true" : "false", dilbert_AssertCollect ? " (failures are collected, not fatal)" : "");
     } else {
       dilbert_Asserts = false;
       printf("Dilbert patches Peano: Assertion MODE env var not given, thus Asserts=%s\n", dilbert_Asserts ? "true" : "false");
     }
     // print the decision, for understanding what goes on.
+
+    // all scopes follow the MODE unless they are given explicitly
+    dilbert_AssertScopes = dilbert_Asserts ? (1u << dilbert::assertions::NumberOfScopes) - 1 : 0;
+    char* scopes = std::getenv("DILBERT_ASSERT_SCOPES");
+    if(scopes!=NULL) {
+      dilbert_AssertScopes = dilbert::assertions::parseScopes(scopes);
+      dilbert_Asserts      = dilbert_AssertScopes!=0;
+      printf("Dilbert patches Peano: DILBERT_ASSERT_SCOPES='%s' was given, therefore checking scopes", scopes);
+      for(int scope=0; scope<dilbert::assertions::NumberOfScopes; scope++) {
+        if(dilbert_AssertScopes & (1u << scope)) printf(" %s", dilbert::assertions::getScopeName(scope));
+      }
+      printf("%s\n", dilbert_AssertScopes==0 ? " (none)" : "");
+    }
+
+    // by default, assertions of all costs are checked
+    char* level = std::getenv("DILBERT_ASSERT_LEVEL");
+    if(level!=NULL) {
+      const int cost = dilbert::assertions::parseCost(level);
+      if(cost>=0) {
+        dilbert_AssertCost = cost;
+      } else {
+        printf("Dilbert patches Peano: Ignoring unknown assertion level '%s'\n", level);
+      }
+      printf("Dilbert patches Peano: DILBERT_ASSERT_LEVEL='%s' was given, therefore checking assertions up to cost %s\n",
+        level, dilbert::assertions::getCostName(dilbert_AssertCost));
+    }
+
+    // by default, the first ten failures of each site are kept in MODE=Collect
+    char* limit = std::getenv("DILBERT_ASSERT_COLLECT_LIMIT");
+    if(limit!=NULL) {
+      const long occurrences = std::atol(limit);
+      dilbert_AssertCollectLimit = occurrences>0 ? occurrences : 0;
+      printf("Dilbert patches Peano: DILBERT_ASSERT_COLLECT_LIMIT='%s' was given, therefore keeping %u failures per site\n",
+        limit, dilbert_AssertCollectLimit);
+    }
+
+    // by default, every evaluation of an assertion is checked
+    char* sample = std::getenv("DILBERT_ASSERT_SAMPLE");
+    if(sample!=NULL) {
+      const long rate = std::atol(sample);
+      dilbert_AssertSample = rate>1 ? rate : 1;
+      printf("Dilbert patches Peano: DILBERT_ASSERT_SAMPLE='%s' was given, therefore checking every %u-th evaluation\n",
+        sample, dilbert_AssertSample);
+    } else {
+      dilbert_AssertSample = 1;
+      printf("Dilbert patches Peano: DILBERT_ASSERT_SAMPLE env var not given, thus checking every evaluation\n");
+    }
+
+    // statistics are off by default
+    char* statistics = std::getenv("DILBERT_ASSERT_STATS");
+    if(statistics!=NULL) {
+      dilbert_AssertStatistics = dilbert::assertions::parseStatistics(statistics);
+      printf("Dilbert patches Peano: DILBERT_ASSERT_STATS='%s' was given, therefore %s\n", statistics,
+        dilbert_AssertStatistics==dilbert::assertions::MeasureCycles    ? "counting evaluations and cycles per assertion" :
+        dilbert_AssertStatistics==dilbert::assertions::CountEvaluations ? "counting evaluations per assertion" :
+                                                                          "collecting no statistics (use counts or cycles)");
+    }
+
+    // the governor needs the cost of each assertion
+    char* budget = std::getenv("DILBERT_ASSERT_BUDGET");
+    if(budget!=NULL) {
+      dilbert_AssertBudget = std::atof(budget);
+      if(dilbert_AssertBudget>0.0) {
+        dilbert_AssertStatistics = dilbert::assertions::MeasureCycles;
+      }
+      printf("Dilbert patches Peano: DILBERT_ASSERT_BUDGET='%s' was given, therefore assertions may take %.1f%% of the runtime%s\n",
+        budget, dilbert_AssertBudget, dilbert_AssertBudget>0.0 ? "" : " (no budget)");
+    }
+
+    // collective assertions need all ranks, so they follow the startup scopes only
+    #ifdef Parallel
+    dilbert_AssertCollectives = dilbert_AssertScopes & (1u << dilbert::assertions::Communication);
+    if(dilbert_AssertCollectives) {
+      printf("Dilbert patches Peano: Parallel scope is checked, therefore collective assertions are reduced at each traversal boundary\n");
+    }
+
+    // a failing rank aborts all ranks, by default immediately
+    char* grace = std::getenv("DILBERT_ASSERT_ABORT_GRACE");
+    if(grace!=NULL) {
+      const int seconds = std::atoi(grace);
+      dilbert_AssertAbortGrace = seconds>0 ? seconds : 0;
+      printf("Dilbert patches Peano: DILBERT_ASSERT_ABORT_GRACE='%s' was given, therefore a failing rank waits %d seconds before aborting all ranks\n",
+        grace, dilbert_AssertAbortGrace);
+    }
+    #endif
+
+    // floating point traps are off by default, MODE=FPTrap traps on NaN, Inf and division by zero
+    char* traps = std::getenv("DILBERT_FPE");
+    if(mode!=NULL && equals(mode, "FPTrap")) {
+      dilbert_FloatingPointTraps = FE_INVALID | FE_DIVBYZERO | FE_OVERFLOW;
+    }
+    if(traps!=NULL) {
+      const int mask = dilbert::assertions::parseFloatingPointTraps(traps);
+      if(mask>=0) {
+        dilbert_FloatingPointTraps = mask;
+      } else {
+        printf("Dilbert patches Peano: Ignoring unknown floating point exceptions '%s' (use invalid,divbyzero,overflow,underflow,inexact)\n", traps);
+      }
+    }
+    if(dilbert_FloatingPointTraps!=0) {
+      #if defined(__GLIBC__)
+      dilbert::assertions::enableFloatingPointTraps();
+      printf("Dilbert patches Peano: Trapping floating point exceptions%s%s%s%s%s, therefore they are reported like failing assertions\n",
+        dilbert_FloatingPointTraps & FE_INVALID   ? " invalid"   : "",
+        dilbert_FloatingPointTraps & FE_DIVBYZERO ? " divbyzero" : "",
+        dilbert_FloatingPointTraps & FE_OVERFLOW  ? " overflow"  : "",
+        dilbert_FloatingPointTraps & FE_UNDERFLOW ? " underflow" : "",
+        dilbert_FloatingPointTraps & FE_INEXACT   ? " inexact"   : "");
+      #else
+      printf("Dilbert patches Peano: Floating point traps need glibc, therefore DILBERT_FPE is ignored\n");
+      #endif
+    }
+
+    // numerical comparisons default to the absolute tolerance of tarch::la::equals()
+    char* tolerance = std::getenv("DILBERT_ASSERT_TOLERANCE");
+    if(tolerance!=NULL) {
+      if(dilbert::assertions::parseNumericalTolerance(tolerance, dilbert_AssertAbsoluteTolerance, dilbert_AssertRelativeTolerance, dilbert_AssertUlpTolerance)) {
+        printf("Dilbert patches Peano: DILBERT_ASSERT_TOLERANCE='%s' was given, therefore numerical assertions accept an absolute difference of %g, a relative one of %g or %lld ulps\n",
+          tolerance, dilbert_AssertAbsoluteTolerance, dilbert_AssertRelativeTolerance, dilbert_AssertUlpTolerance);
+      } else {
+        printf("Dilbert patches Peano: Ignoring malformed DILBERT_ASSERT_TOLERANCE='%s' (use e.g. 1e-12,rel:1e-10,ulp:4)\n", tolerance);
+      }
+    }
+
+    // the cell order of patches, Peano's own grid traversal is not affected
+    char* order = std::getenv("DILBERT_CELL_ORDER");
+    if(peano::grid::aspects::CellLocalSpaceFillingCurve::selectCurve(order)) {
+      if(order!=NULL) {
+        printf("Dilbert patches Peano: DILBERT_CELL_ORDER='%s' was given, therefore CellLocalSpaceFillingCurve orders patch cells along the %s curve (the grid traversal keeps the Peano curve)\n",
+          order, peano::grid::aspects::CellLocalSpaceFillingCurve::getCurveName(peano::grid::aspects::CellLocalSpaceFillingCurve::curve));
+      }
+    } else {
+      printf("Dilbert patches Peano: Ignoring unknown DILBERT_CELL_ORDER='%s' (use peano, hilbert or morton), therefore using the %s curve\n",
+        order, peano::grid::aspects::CellLocalSpaceFillingCurve::getCurveName(peano::grid::aspects::CellLocalSpaceFillingCurve::curve));
+    }
+
+    // the flight recorder is off by default
+    dilbert_FlightRecorder = std::getenv("DILBERT_FLIGHT_RECORDER");
+    if(dilbert_FlightRecorder!=NULL && std::strlen(dilbert_FlightRecorder)>dilbert::assertions::MaxFilePrefixLength) {
+      printf("Dilbert patches Peano: Ignoring DILBERT_FLIGHT_RECORDER, as it is longer than %d characters\n", dilbert::assertions::MaxFilePrefixLength);
+      dilbert_FlightRecorder = NULL;
+    }
+    if(dilbert_FlightRecorder!=NULL) {
+      dilbert::assertions::installFlightRecorder();
+      printf("Dilbert patches Peano: DILBERT_FLIGHT_RECORDER='%s' was given, therefore failing assertions write %s-rank<r>.bin\n",
+        dilbert_FlightRecorder, dilbert_FlightRecorder);
+    }
+
+    // by default, all traversals are checked
+    char* window = std::getenv("DILBERT_ASSERT_WINDOW");
+    if(window!=NULL) {
+      int first, end;
+      if(dilbert::assertions::parseWindow(window, first, end)) {
+        dilbert::assertions::installWindow(dilbert_AssertScopes, first, end);
+        if(end<0) {
+          printf("Dilbert patches Peano: DILBERT_ASSERT_WINDOW='%s' was given, therefore checking from traversal %d on\n", window, first);
+        } else {
+          printf("Dilbert patches Peano: DILBERT_ASSERT_WINDOW='%s' was given, therefore checking traversals %d to %d\n", window, first, end-1);
+        }
+      } else {
+        printf("Dilbert patches Peano: Ignoring malformed assertion window '%s' (use first:end)\n", window);
+      }
+    }
+
+    dilbert::assertions::updateStaticBranches();
+    dilbert::assertions::selectKernelVariants();
+
+    // switch on/off while running, applied at dilbert::assertions::onTraversalBoundary()
+    char* signals = std::getenv("DILBERT_ASSERT_SIGNALS");
+    char* control = std::getenv("DILBERT_ASSERT_CONTROL");
+    if(signals!=NULL || control!=NULL) {
+      const bool useSignals = signals!=NULL && !equals(signals, "0") && !equals(signals, "no");
+      dilbert::assertions::installRuntimeSwitches(scopes!=NULL ? dilbert::assertions::parseScopes(scopes) : 0, useSignals, control);
+      if(useSignals) {
+        printf("Dilbert patches Peano: SIGUSR1 switches assertions on, SIGUSR2 switches them off\n");
+      }
+      if(control!=NULL) {
+        printf("Dilbert patches Peano: Watching assertion control file %s\n", control);
+      }
+    }
   } /* DILBERT END */
 
   #ifdef Parallel
   if ( tarch::parallel::Node::getInstance().init(argc,argv) ) {
     tarch::parallel::NodePool::getInstance().init();
+
+    // rank sampling needs the rank, so it follows the MPI initialisation
+    /* DILBERT START */ {
+      dilbert::assertions::recordOrigin();
+
+      char* ranks = std::getenv("DILBERT_ASSERT_RANKS");
+      if(ranks!=NULL) {
+        const int rank          = tarch::parallel::Node::getInstance().getRank();
+        const int numberOfRanks = tarch::parallel::Node::getInstance().getNumberOfNodes();
+        bool selected;
+        if(dilbert::assertions::parseRanks(ranks, rank, numberOfRanks, selected)) {
+          printf("Dilbert patches Peano: DILBERT_ASSERT_RANKS='%s' was given, therefore rank %d of %d checks %s\n",
+            ranks, rank, numberOfRanks, selected ? "assertions" : "no assertions");
+          dilbert::assertions::selectRank(selected);
+        } else if(rank==0) {
+          printf("Dilbert patches Peano: Ignoring malformed rank selection '%s' (use every:k, random:p or a list)\n", ranks);
+        }
+      }
+    } /* DILBERT END */
     return 0;
   }
   else {
@@ -70,7 +302,31 @@ int peano::initParallelEnvironment(int* argc, char*** argv) {
 }
 
 
+/* DILBERT START */
+void peano::addCheckpointHook(dilbert::assertions::CheckpointHook hook, void* data) {
+  if(dilbert::assertions::addCheckpointHook(hook, data)) {
+    printf("Dilbert patches Peano: Checkpoint hook registered, therefore failing assertions, SIGABRT and SIGTERM write a checkpoint first\n");
+  } else {
+    printf("Dilbert patches Peano: Ignoring checkpoint hook, as there are %d hooks already\n", dilbert::assertions::MaxCheckpointHooks);
+  }
+}
+/* DILBERT END */
+
+
 void peano::shutdownParallelEnvironment() {
+  /* DILBERT START */
+  if(dilbert_AssertCollect) {
+    dilbert::assertions::reportViolations(tarch::parallel::Node::getInstance().getRank());
+  }
+  if(dilbert_AssertStatistics!=dilbert::assertions::NoStatistics) {
+    dilbert::assertions::reportStatistics(
+      tarch::parallel::Node::getInstance().getRank(),
+      std::getenv("DILBERT_ASSERT_STATS_FILE")
+    );
+  }
+  dilbert::assertions::forgetOrigin();
+  /* DILBERT END */
+
   tarch::parallel::NodePool::getInstance().shutdown();
   tarch::parallel::Node::getInstance().shutdown();
 }
@@ -0,0 +1,35 @@
+/**
+ * Dilbert -- a patch for Peano.
+ * This file is a Dilbert patch file.
+ **/
+
+#include "peano/utils/IndexMapping.h"
+
+#include <strings.h>
+
+
+peano::utils::indexmapping::Backend peano::utils::indexmapping::backend = peano::utils::indexmapping::Automatic;
+
+
+bool peano::utils::indexmapping::selectBackend(const char* name) {
+  backend = Automatic;
+  if (name==NULL) {
+    return true;
+  }
+
+  if (strcasecmp(name, "automatic")==0) {
+    backend = Automatic;
+  } else if (strcasecmp(name, "table")==0) {
+    backend = Table;
+  } else if (strcasecmp(name, "arithmetic")==0) {
+    backend = Arithmetic;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+
+const char* peano::utils::indexmapping::getBackendName(Backend backend) {
+  return backend==Arithmetic ? "arithmetic" : backend==Table ? "table" : "automatic";
+}
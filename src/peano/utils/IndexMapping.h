@@ -0,0 +1,118 @@
+/**
+ * Dilbert -- a patch for Peano.
+ * This file is a Dilbert patch file.
+ **/
+
+#ifndef _PEANO_UTILS_INDEX_MAPPING_H_
+#define _PEANO_UTILS_INDEX_MAPPING_H_
+
+#include "peano/utils/Globals.h"
+#include "peano/utils/LookupTables.h"
+#include "tarch/Assertions.h"
+
+
+namespace peano {
+  namespace utils {
+    /**
+     * Mapping of a d-dimensional counter within a cube of max^DIMENSIONS
+     * entries onto its linearised index counter[0] + counter[1]*max + ...
+     * and back, i.e. what the DLinearised and DDelinearised tables do.
+     * There are two backends:
+     *
+     * - Table looks the counters up in the constexpr tables of
+     *   peano/utils/LookupTables.h (max up to 4).
+     * - Arithmetic computes them (shifts for powers of two, divisions
+     *   otherwise) and needs no table.
+     *
+     * Table falls back to Arithmetic for max>4. The default Automatic
+     * takes Arithmetic for powers of two, where it gets along with shifts,
+     * and Table otherwise. peano::fillLookupTables() can overrule it via
+     *
+     *   export DILBERT_INDEX_MAPPING=automatic|table|arithmetic
+     *
+     * The switch in the lookups is perfectly predictable. See
+     * benchmarks/index-mapping.cpp for a comparison.
+     */
+    namespace indexmapping {
+      enum Backend {
+        Automatic = 0,
+        Table,
+        Arithmetic
+      };
+
+      extern Backend backend;
+
+      /**
+       * Sets backend, NULL selects Automatic. Returns false for an unknown
+       * name and keeps Automatic then.
+       */
+      bool selectBackend(const char* name);
+
+      /**
+       * "automatic", "table" or "arithmetic".
+       */
+      const char* getBackendName(Backend backend);
+
+      constexpr bool isPowerOfTwo(int max) {
+        return max>0 && (max & (max-1))==0;
+      }
+
+      inline int dLinearisedArithmetic(const int* counter, int max) {
+        int result = 0;
+        for (int d=DIMENSIONS-1; d>=0; d--) {
+          result = result*max + counter[d];
+        }
+        return result;
+      }
+
+      inline void dDelinearisedArithmetic(int value, int max, int* counter) {
+        assertion1( max>0, max );
+        if (isPowerOfTwo(max)) {
+          const int bits = __builtin_ctz(max);
+          for (int d=0; d<DIMENSIONS; d++) {
+            counter[d] = (value >> (bits*d)) & (max-1);
+          }
+        } else {
+          for (int d=0; d<DIMENSIONS; d++) {
+            counter[d] = value % max;
+            value     /= max;
+          }
+        }
+      }
+
+      inline void dDelinearisedTable(int value, int max, int* counter) {
+        const int* entries;
+        switch (max) {
+          case 2:  entries = lookup::DelinearisedTable<2>::values; break;
+          case 3:  entries = lookup::DelinearisedTable<3>::values; break;
+          case 4:  entries = lookup::DelinearisedTable<4>::values; break;
+          default: dDelinearisedArithmetic(value, max, counter); return;
+        }
+        for (int d=0; d<DIMENSIONS; d++) {
+          counter[d] = entries[value*DIMENSIONS+d];
+        }
+      }
+
+      /**
+       * counter[0] + counter[1]*max + ... for DIMENSIONS counters.
+       */
+      inline int dLinearised(const int* counter, int max) {
+        return dLinearisedArithmetic(counter, max);
+      }
+
+      /**
+       * Inverse of dLinearised(). For a constant max, the choice of
+       * Automatic folds at compile time.
+       */
+      inline void dDelinearised(int value, int max, int* counter) {
+        if (backend==Arithmetic || (backend==Automatic && isPowerOfTwo(max))) {
+          dDelinearisedArithmetic(value, max, counter);
+        } else {
+          dDelinearisedTable(value, max, counter);
+        }
+      }
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,159 @@
+/**
+ * Dilbert -- a patch for Peano.
+ * This file is a Dilbert patch file.
+ **/
+
+#ifndef _PEANO_UTILS_LOOKUP_TABLES_H_
+#define _PEANO_UTILS_LOOKUP_TABLES_H_
+
+#include "peano/utils/Globals.h"
+
+
+namespace peano {
+  namespace utils {
+    /**
+     * Compile-time counterparts of the lookup tables which
+     * peano::fillLookupTables() sets up at startup (TwoPowI, ThreePowI,
+     * FourPowI, DPowI, DLinearised and DDelinearised). The tables are
+     * constexpr arrays, i.e. they are constant-initialised into read-only
+     * data and there is nothing to set up. DLinearised is a constexpr
+     * function only: A table indexed by the counters would just hold the
+     * multiply-adds of its own index. Lookups with constant arguments
+     * fold at compile time, e.g.
+     *
+     * \code
+     * static_assert( peano::utils::lookup::threePowI(DIMENSIONS)==THREE_POWER_D, "" );
+     * \endcode
+     *
+     * and all others are plain loads which the compiler knows not to alias
+     * with anything. Everything is C++11 (constexpr functions with a single
+     * return statement).
+     *
+     * Peano's own lookups in Loop.h and Globals.h, which are not part of
+     * this patch, still read the runtime tables, so fillLookupTables() keeps
+     * setting them up. Dilbert code such as peano::utils::indexmapping uses
+     * these tables instead.
+     */
+    namespace lookup {
+      /**
+       * base^exponent, evaluated by the compiler.
+       */
+      constexpr int power(int base, int exponent) {
+        return exponent==0 ? 1 : base*power(base, exponent-1);
+      }
+
+      /**
+       * Largest exponent such that base^exponent still fits into an int.
+       */
+      constexpr int maxExponent(int base, int exponent=0, long long value=1) {
+        return value*base > 0x7fffffffLL ? exponent : maxExponent(base, exponent+1, value*base);
+      }
+
+      /**
+       * 0, ..., N-1 as template parameter pack (std::index_sequence is
+       * C++14). The pack is built from two halves, i.e. the instantiation
+       * depth is log(N): The 4^d*d entries of DelinearisedTable<4> exceed
+       * the compilers' depth limit (900 for GCC) from d=4 on otherwise.
+       */
+      template <int... I>
+      struct Indices {};
+
+      template <typename Lower, typename Upper>
+      struct ConcatenateIndices;
+
+      template <int... I, int... J>
+      struct ConcatenateIndices<Indices<I...>, Indices<J...> > {
+        typedef Indices<I..., static_cast<int>(sizeof...(I))+J...> Type;
+      };
+
+      template <int N>
+      struct MakeIndices {
+        typedef typename ConcatenateIndices<typename MakeIndices<N/2>::Type, typename MakeIndices<N-N/2>::Type>::Type Type;
+      };
+
+      template <>
+      struct MakeIndices<0> {
+        typedef Indices<> Type;
+      };
+
+      template <>
+      struct MakeIndices<1> {
+        typedef Indices<0> Type;
+      };
+
+      /**
+       * values[i] = Base^i for all i such that the power fits into an int.
+       */
+      template <int Base, int Size=maxExponent(Base)+1, typename = typename MakeIndices<Size>::Type>
+      struct PowerTable;
+
+      template <int Base, int Size, int... I>
+      struct PowerTable<Base, Size, Indices<I...> > {
+        static constexpr int size = Size;
+        static constexpr int values[Size] = { power(Base, I)... };
+      };
+
+      template <int Base, int Size, int... I>
+      constexpr int PowerTable<Base, Size, Indices<I...> >::values[Size];
+
+      constexpr int twoPowI(int i)   { return PowerTable<2>::values[i]; }
+      constexpr int threePowI(int i) { return PowerTable<3>::values[i]; }
+      constexpr int fourPowI(int i)  { return PowerTable<4>::values[i]; }
+
+      /**
+       * DIMENSIONS^i.
+       */
+      constexpr int dPowI(int i)     { return PowerTable<DIMENSIONS>::values[i]; }
+
+      /**
+       * Component axis of the d-dimensional index with linearised value
+       * within a cube of max^DIMENSIONS entries (axis 0 runs fastest).
+       */
+      constexpr int dDelinearised(int value, int max, int axis) {
+        return value / power(max, axis) % max;
+      }
+
+      /**
+       * Inverse of dDelinearised(), i.e. counter0 + counter1*max + ...
+       * for DIMENSIONS counters.
+       */
+      constexpr int dLinearised(int) {
+        return 0;
+      }
+
+      template <typename... Counters>
+      constexpr int dLinearised(int max, int counter, Counters... counters) {
+        return counter + max * dLinearised(max, counters...);
+      }
+
+      /**
+       * values[value*DIMENSIONS+axis] = dDelinearised(value,Max,axis) for
+       * all Max^DIMENSIONS entries of a cube, e.g. the vertices (Max=2) or
+       * the 3^d neighbours of a cell (Max=3). These replace the loops over
+       * DDelinearised in the dfor macros.
+       */
+      template <int Max, int Size=power(Max,DIMENSIONS)*DIMENSIONS, typename = typename MakeIndices<Size>::Type>
+      struct DelinearisedTable;
+
+      template <int Max, int Size, int... I>
+      struct DelinearisedTable<Max, Size, Indices<I...> > {
+        static constexpr int values[Size] = { dDelinearised(I/DIMENSIONS, Max, I%DIMENSIONS)... };
+      };
+
+      template <int Max, int Size, int... I>
+      constexpr int DelinearisedTable<Max, Size, Indices<I...> >::values[Size];
+
+      template <int Max>
+      constexpr int dDelinearised(int value, int axis) {
+        return DelinearisedTable<Max>::values[value*DIMENSIONS+axis];
+      }
+
+      static_assert( twoPowI(DIMENSIONS)==TWO_POWER_D,     "TwoPowI table does not match TWO_POWER_D" );
+      static_assert( threePowI(DIMENSIONS)==THREE_POWER_D, "ThreePowI table does not match THREE_POWER_D" );
+      static_assert( fourPowI(15)==1073741824,             "FourPowI table is broken" );
+      static_assert( dDelinearised<3>(THREE_POWER_D-1, DIMENSIONS-1)==2, "DDelinearised table is broken" );
+    }
+  }
+}
+
+#endif
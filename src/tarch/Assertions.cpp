@@ -0,0 +1,1977 @@
+/**
+ * Dilbert -- a patch for Peano.
+ * This file is a Dilbert patch file.
+ **/
+
+#include "tarch/Assertions.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cfloat>
+#include <cmath>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <fenv.h>
+#include <mutex>
+#include <new>
+#include <string>
+#include <strings.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#else
+#include <thread>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+
+namespace {
+  const char* ScopeNames[dilbert::assertions::NumberOfScopes] = {
+    "la", "grid", "heap", "parallel", "kernel", "user"
+  };
+
+  const char* CostNames[dilbert::assertions::NumberOfCosts] = {
+    "cheap", "normal", "expensive", "paranoid"
+  };
+}
+
+
+const char* dilbert::assertions::getCostName(int cost) {
+  return (cost>=0 && cost<NumberOfCosts) ? CostNames[cost] : "unknown";
+}
+
+
+int dilbert::assertions::parseCost(const char* cost) {
+  for (int i=0; i<NumberOfCosts; i++) {
+    if (strcasecmp(cost, CostNames[i])==0) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+
+const char* dilbert::assertions::getScopeName(int scope) {
+  return (scope>=0 && scope<NumberOfScopes) ? ScopeNames[scope] : "unknown";
+}
+
+
+unsigned int dilbert::assertions::parseScopes(const char* scopes) {
+  unsigned int result = 0;
+  const char*  token  = scopes;
+  while (*token!='\0') {
+    const char* end    = std::strchr(token, ',');
+    const int   length = end==NULL ? std::strlen(token) : end-token;
+
+    bool found = false;
+    if (length==3 && strncasecmp(token, "all", 3)==0) {
+      result = (1u << NumberOfScopes) - 1;
+      found  = true;
+    }
+    if (length==4 && strncasecmp(token, "none", 4)==0) {
+      found  = true;
+    }
+    for (int scope=0; scope<NumberOfScopes; scope++) {
+      if (static_cast<int>(std::strlen(ScopeNames[scope]))==length && strncasecmp(token, ScopeNames[scope], length)==0) {
+        result |= 1u << scope;
+        found   = true;
+      }
+    }
+    if (!found && length>0) {
+      printf("Dilbert patches Peano: Ignoring unknown assertion scope '%.*s'\n", length, token);
+    }
+
+    token = end==NULL ? token+length : end+1;
+  }
+  return result;
+}
+
+
+#ifdef DILBERT_STATIC_BRANCHES
+#include <stdint.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/**
+ * Begin and end of the section holding all static branches. Both symbols are
+ * generated by the linker. They are weak as there might be no assertion in
+ * the whole binary.
+ */
+extern "C" {
+  extern dilbert::assertions::StaticBranch __start_dilbert_static_branches[] __attribute__((weak));
+  extern dilbert::assertions::StaticBranch __stop_dilbert_static_branches[] __attribute__((weak));
+}
+
+
+namespace {
+  const int           StaticBranchSize = 5;
+  const unsigned char Nop[StaticBranchSize] = { 0x0f, 0x1f, 0x44, 0x00, 0x00 };
+
+  /**
+   * Either the five byte NOP or a relative jump to the target.
+   */
+  void getInstruction(const dilbert::assertions::StaticBranch& branch, bool enabled, unsigned char* instruction) {
+    if (enabled) {
+      const int32_t offset = static_cast<int32_t>( branch.target - (branch.code + StaticBranchSize) );
+      instruction[0] = 0xe9;
+      std::memcpy(instruction+1, &offset, sizeof(offset));
+    }
+    else {
+      std::memcpy(instruction, Nop, StaticBranchSize);
+    }
+  }
+}
+
+
+bool dilbert::assertions::updateStaticBranches() {
+  StaticBranch* begin = __start_dilbert_static_branches;
+  StaticBranch* end   = __stop_dilbert_static_branches;
+  if (begin==NULL || begin==end) {
+    return true;
+  }
+
+  // The branches spread all over the text segment. We unprotect the whole
+  // range once instead of doing one system call per branch.
+  unsigned long first = begin->code;
+  unsigned long last  = begin->code;
+  for (StaticBranch* p=begin; p!=end; p++) {
+    first = p->code < first ? p->code : first;
+    last  = p->code > last  ? p->code : last;
+  }
+  const unsigned long pageSize = sysconf(_SC_PAGESIZE);
+  const unsigned long from     = first & ~(pageSize-1);
+  const unsigned long length   = last + StaticBranchSize - from;
+
+  if ( mprotect(reinterpret_cast<void*>(from), length, PROT_READ | PROT_WRITE | PROT_EXEC)!=0 ) {
+    printf("Dilbert patches Peano: Cannot patch %ld static assertion branches, assertions remain switched off\n", static_cast<long>(end-begin));
+    return false;
+  }
+
+  int patched = 0;
+  for (StaticBranch* p=begin; p!=end; p++) {
+    unsigned char instruction[StaticBranchSize];
+    getInstruction(*p, isKeyEnabled(p->key), instruction);
+    if ( std::memcmp(reinterpret_cast<void*>(p->code), instruction, StaticBranchSize)!=0 ) {
+      std::memcpy(reinterpret_cast<void*>(p->code), instruction, StaticBranchSize);
+      patched++;
+    }
+  }
+
+  mprotect(reinterpret_cast<void*>(from), length, PROT_READ | PROT_EXEC);
+
+  // window and signal switches re-patch, we only report the initial setup
+  static bool reported = false;
+  if (!reported) {
+    printf("Dilbert patches Peano: Patched %d of %ld static assertion branches\n", patched, static_cast<long>(end-begin));
+    reported = true;
+  }
+  return true;
+}
+
+#else
+
+bool dilbert::assertions::updateStaticBranches() {
+  return true;
+}
+
+#endif
+
+
+dilbert::assertions::KernelVariantsBase* dilbert::assertions::KernelVariantsBase::_first = NULL;
+
+
+namespace {
+  /**
+   * Guards the list of kernel variants. Local static, as the objects of
+   * other translation units may register before this one is initialised.
+   */
+  std::mutex& getKernelVariantsMutex() {
+    static std::mutex mutex;
+    return mutex;
+  }
+}
+
+
+dilbert::assertions::KernelVariantsBase::KernelVariantsBase() {
+  std::lock_guard<std::mutex> lock(getKernelVariantsMutex());
+  _next  = _first;
+  _first = this;
+}
+
+
+dilbert::assertions::KernelVariantsBase::~KernelVariantsBase() {
+  std::lock_guard<std::mutex> lock(getKernelVariantsMutex());
+  for (KernelVariantsBase** p=&_first; *p!=NULL; p=&(*p)->_next) {
+    if (*p==this) {
+      *p = _next;
+      break;
+    }
+  }
+}
+
+
+void dilbert::assertions::selectKernelVariants() {
+  std::lock_guard<std::mutex> lock(getKernelVariantsMutex());
+  for (KernelVariantsBase* p=KernelVariantsBase::_first; p!=NULL; p=p->_next) {
+    p->select(dilbert_Asserts);
+  }
+}
+
+
+namespace {
+  unsigned long long readTimer() {
+    #if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+    #else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    #endif
+  }
+
+  struct Counter {
+    unsigned long long evaluations;
+    unsigned long long cycles;
+    unsigned long long windowCycles;
+    unsigned int       countdown;
+  };
+
+  /**
+   * Each thread counts into a vector of its own which is indexed by the site
+   * id. Vectors are never freed, so the counts of finished threads survive
+   * until the report.
+   *
+   * The window entries are used by the budget governor: Each thread
+   * compares the cycles spent in (outermost) assertions with the cycles
+   * passed since the window has started.
+   */
+  struct ThreadStatistics {
+    std::vector<Counter> counters;
+
+    static const int MaxDepth = 16;
+    int                        ids[MaxDepth];
+    unsigned long long         starts[MaxDepth];
+    int                        depth;
+
+    unsigned long long         windowStart;
+    unsigned long long         windowCycles;
+    int                        windowEvaluations;
+
+    ThreadStatistics(): depth(0), windowStart(readTimer()), windowCycles(0), windowEvaluations(0) {}
+
+    Counter& getCounter(int id) {
+      if (id>=static_cast<int>(counters.size())) {
+        Counter empty = {0, 0, 0, 0};
+        counters.resize(id+1, empty);
+      }
+      return counters[id];
+    }
+  };
+
+  /**
+   * Number of outermost evaluations per governor window.
+   */
+  const int GovernorWindow = 1 << 12;
+
+  std::mutex                                 statisticsMutex;
+  std::vector<dilbert::assertions::Site*>    registeredSites;
+  std::vector<ThreadStatistics*>             threadStatistics;
+  thread_local ThreadStatistics*             myStatistics = NULL;
+
+  int registerSite(dilbert::assertions::Site& site) {
+    std::lock_guard<std::mutex> lock(statisticsMutex);
+    if (site.id.load()<0) {
+      registeredSites.push_back(&site);
+      site.id.store( static_cast<int>(registeredSites.size())-1 );
+    }
+    return site.id.load();
+  }
+
+  ThreadStatistics& getMyStatistics() {
+    if (myStatistics==NULL) {
+      myStatistics = new ThreadStatistics();
+      std::lock_guard<std::mutex> lock(statisticsMutex);
+      threadStatistics.push_back(myStatistics);
+    }
+    return *myStatistics;
+  }
+
+  int getId(dilbert::assertions::Site& site) {
+    const int id = site.id.load(std::memory_order_relaxed);
+    return id>=0 ? id : registerSite(site);
+  }
+
+  /**
+   * Called at the end of each window. If the thread has spent more than the
+   * budget in assertions, the site which has been most expensive within the
+   * window is demoted.
+   */
+  void govern(ThreadStatistics& statistics) {
+    const unsigned long long now     = readTimer();
+    const double             elapsed = static_cast<double>(now - statistics.windowStart);
+    const double             share   = elapsed>0.0 ? 100.0 * statistics.windowCycles / elapsed : 0.0;
+
+    if (share>dilbert_AssertBudget) {
+      // other threads may register sites and thus reallocate registeredSites
+      dilbert::assertions::Site* worst = NULL;
+      {
+        std::lock_guard<std::mutex> lock(statisticsMutex);
+        int worstId = -1;
+        for (unsigned int id=0; id<statistics.counters.size(); id++) {
+          const bool demotable = registeredSites[id]->demotion.load(std::memory_order_relaxed)<dilbert::assertions::MaxDemotion;
+          if (demotable && (worstId<0 || statistics.counters[id].windowCycles>statistics.counters[worstId].windowCycles)) {
+            worstId = id;
+          }
+        }
+        worst = worstId>=0 ? registeredSites[worstId] : NULL;
+      }
+      if (worst!=NULL) {
+        dilbert::assertions::Site& site = *worst;
+        const int demotion = site.demotion.fetch_add(1) + 1;
+        if (demotion>=dilbert::assertions::MaxDemotion) {
+          printf("Dilbert patches Peano: Assertions took %.1f%% of the runtime (budget %.1f%%), switching off %s:%d: %s\n",
+            share, dilbert_AssertBudget, site.file, site.line, site.condition);
+        }
+        else {
+          printf("Dilbert patches Peano: Assertions took %.1f%% of the runtime (budget %.1f%%), checking %s:%d: %s only every %d-th time\n",
+            share, dilbert_AssertBudget, site.file, site.line, site.condition, 1 << demotion);
+        }
+      }
+    }
+
+    for (unsigned int id=0; id<statistics.counters.size(); id++) {
+      statistics.counters[id].windowCycles = 0;
+    }
+    statistics.windowStart       = readTimer();
+    statistics.windowCycles      = 0;
+    statistics.windowEvaluations = 0;
+  }
+
+  struct SiteSummary {
+    dilbert::assertions::Site* site;
+    unsigned long long         evaluations;
+    unsigned long long         cycles;
+    int                        threads;
+  };
+
+  bool isMoreExpensive(const SiteSummary& a, const SiteSummary& b) {
+    return a.cycles!=b.cycles ? a.cycles>b.cycles : a.evaluations>b.evaluations;
+  }
+}
+
+
+int dilbert::assertions::parseStatistics(const char* statistics) {
+  if (strcasecmp(statistics, "counts")==0) return CountEvaluations;
+  if (strcasecmp(statistics, "cycles")==0) return MeasureCycles;
+  return NoStatistics;
+}
+
+
+bool dilbert::assertions::startEvaluation(Site& site) {
+  ThreadStatistics& statistics = getMyStatistics();
+  const int         id         = getId(site);
+
+  const int demotion = site.demotion.load(std::memory_order_relaxed);
+  if (demotion>0) {
+    Counter& counter = statistics.getCounter(id);
+    if (demotion>=MaxDemotion) {
+      return false;
+    }
+    if (counter.countdown>0) {
+      counter.countdown--;
+      return false;
+    }
+    counter.countdown = (1u << demotion) - 1;
+  }
+
+  if (statistics.depth<ThreadStatistics::MaxDepth) {
+    statistics.ids[statistics.depth]    = id;
+    statistics.starts[statistics.depth] = dilbert_AssertStatistics==MeasureCycles ? readTimer() : 0;
+  }
+  statistics.depth++;
+  return true;
+}
+
+
+bool dilbert::assertions::stopEvaluation(bool failed) {
+  ThreadStatistics& statistics = getMyStatistics();
+  statistics.depth--;
+  if (statistics.depth<ThreadStatistics::MaxDepth) {
+    Counter& counter = statistics.getCounter(statistics.ids[statistics.depth]);
+    counter.evaluations++;
+    if (dilbert_AssertStatistics==MeasureCycles) {
+      const unsigned long long cycles = readTimer() - statistics.starts[statistics.depth];
+      counter.cycles       += cycles;
+      counter.windowCycles += cycles;
+      if (statistics.depth==0) {
+        statistics.windowCycles += cycles;
+        statistics.windowEvaluations++;
+      }
+    }
+  }
+  if (dilbert_AssertBudget>0.0 && statistics.windowEvaluations>=GovernorWindow) {
+    govern(statistics);
+  }
+  return failed;
+}
+
+
+void dilbert::assertions::reportStatistics(int rank, const char* csvFile) {
+  std::lock_guard<std::mutex> lock(statisticsMutex);
+
+  std::vector<SiteSummary> summaries(registeredSites.size());
+  for (unsigned int id=0; id<registeredSites.size(); id++) {
+    summaries[id].site        = registeredSites[id];
+    summaries[id].evaluations = 0;
+    summaries[id].cycles      = 0;
+    summaries[id].threads     = 0;
+  }
+  for (unsigned int thread=0; thread<threadStatistics.size(); thread++) {
+    const std::vector<Counter>& counters = threadStatistics[thread]->counters;
+    for (unsigned int id=0; id<counters.size(); id++) {
+      summaries[id].evaluations += counters[id].evaluations;
+      summaries[id].cycles      += counters[id].cycles;
+      summaries[id].threads     += counters[id].evaluations>0 ? 1 : 0;
+    }
+  }
+  std::sort(summaries.begin(), summaries.end(), isMoreExpensive);
+
+  const unsigned int MaxLines = 20;
+  printf("Dilbert patches Peano: Assertion statistics of rank %d (%d sites, %d threads), most expensive first:\n",
+    rank, static_cast<int>(summaries.size()), static_cast<int>(threadStatistics.size()));
+  printf("  %20s %16s %8s %8s  %s\n", "cycles", "evaluations", "threads", "demoted", "site");
+  for (unsigned int i=0; i<summaries.size() && i<MaxLines; i++) {
+    printf("  %20llu %16llu %8d %8d  %s:%d: %s\n",
+      summaries[i].cycles, summaries[i].evaluations, summaries[i].threads, summaries[i].site->demotion.load(),
+      summaries[i].site->file, summaries[i].site->line, summaries[i].site->condition);
+  }
+
+  if (csvFile!=NULL) {
+    FILE* file = std::fopen(csvFile, "w");
+    if (file==NULL) {
+      printf("Dilbert patches Peano: Cannot write assertion statistics to %s\n", csvFile);
+      return;
+    }
+    std::fprintf(file, "rank,file,line,condition,evaluations,cycles,threads,demotion\n");
+    for (unsigned int i=0; i<summaries.size(); i++) {
+      // conditions can contain commas and quotes
+      std::fprintf(file, "%d,%s,%d,\"", rank, summaries[i].site->file, summaries[i].site->line);
+      for (const char* c=summaries[i].site->condition; *c!='\0'; c++) {
+        if (*c=='"') std::fputc('"', file);
+        std::fputc(*c, file);
+      }
+      std::fprintf(file, "\",%llu,%llu,%d,%d\n", summaries[i].evaluations, summaries[i].cycles, summaries[i].threads, summaries[i].site->demotion.load());
+    }
+    std::fclose(file);
+  }
+}
+
+
+namespace {
+  unsigned int          switchedScopes = 0;
+  volatile sig_atomic_t pendingSignal  = 0;
+  std::string           controlFile;
+  time_t                controlFileTime = 0;
+  int                   traversal      = 0;
+  unsigned int          windowScopes   = 0;
+  int                   windowFirst    = -1;
+  int                   windowEnd      = -1;
+  bool                  rankSelected   = true;
+
+  void handleSignal(int signal) {
+    pendingSignal = signal;
+  }
+
+  void switchScopes(unsigned int scopes, const char* reason) {
+    if (!rankSelected) {
+      return;
+    }
+    dilbert_AssertScopes = scopes;
+    dilbert_Asserts      = scopes!=0;
+    printf("Dilbert patches Peano: %s, therefore checking scopes", reason);
+    for (int scope=0; scope<dilbert::assertions::NumberOfScopes; scope++) {
+      if (scopes & (1u << scope)) printf(" %s", dilbert::assertions::getScopeName(scope));
+    }
+    printf("%s\n", scopes==0 ? " (none)" : "");
+
+    dilbert::assertions::updateStaticBranches();
+    dilbert::assertions::selectKernelVariants();
+  }
+
+  /**
+   * Returns true and the new scopes if the control file has changed since
+   * the last call.
+   */
+  bool readControlFile(unsigned int& scopes) {
+    struct stat status;
+    if (controlFile.empty() || stat(controlFile.c_str(), &status)!=0 || status.st_mtime==controlFileTime) {
+      return false;
+    }
+    controlFileTime = status.st_mtime;
+
+    char  content[256] = "";
+    FILE* file = std::fopen(controlFile.c_str(), "r");
+    if (file==NULL) {
+      return false;
+    }
+    const size_t length = std::fread(content, 1, sizeof(content)-1, file);
+    std::fclose(file);
+    content[length] = '\0';
+    content[std::strcspn(content, " \t\r\n")] = '\0';
+
+    scopes = dilbert::assertions::parseScopes(content);
+    return true;
+  }
+}
+
+
+void dilbert::assertions::installRuntimeSwitches(unsigned int scopes, bool signals, const char* file) {
+  switchedScopes = scopes==0 ? (1u << NumberOfScopes) - 1 : scopes;
+
+  if (signals) {
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = handleSignal;
+    action.sa_flags   = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGUSR1, &action, NULL);
+    sigaction(SIGUSR2, &action, NULL);
+  }
+
+  if (file!=NULL) {
+    controlFile = file;
+    // changes before the start do not count
+    struct stat status;
+    controlFileTime = stat(file, &status)==0 ? status.st_mtime : 0;
+  }
+}
+
+
+void dilbert::assertions::installWindow(unsigned int scopes, int first, int end) {
+  windowScopes = scopes==0 ? (1u << NumberOfScopes) - 1 : scopes;
+  windowFirst  = first;
+  windowEnd    = end;
+
+  const bool inside    = first<=0 && (end<0 || end>0);
+  dilbert_AssertScopes = inside ? windowScopes : 0;
+  dilbert_Asserts      = dilbert_AssertScopes!=0;
+}
+
+
+bool dilbert::assertions::parseWindow(const char* window, int& first, int& end) {
+  const char* separator = std::strchr(window, ':');
+  if (separator==NULL) {
+    return false;
+  }
+  first = separator==window   ? 0  : std::atoi(window);
+  end   = separator[1]=='\0' ? -1 : std::atoi(separator+1);
+  return first>=0 && (end<0 || end>first);
+}
+
+
+bool dilbert::assertions::parseRanks(const char* ranks, int rank, int numberOfRanks, bool& selected) {
+  if (std::strncmp(ranks, "every:", 6)==0) {
+    const int stride = std::atoi(ranks+6);
+    selected = stride>0 && rank % stride==0;
+    return stride>0;
+  }
+
+  if (std::strncmp(ranks, "random:", 7)==0) {
+    char* end;
+    const double fraction = std::strtod(ranks+7, &end);
+    unsigned long long seed = *end==':' ? std::strtoull(end+1, NULL, 10) : 0;
+
+    // splitmix64 of rank and seed, such that all ranks decide independently
+    unsigned long long hash = seed + (static_cast<unsigned long long>(rank)+1) * 0x9e3779b97f4a7c15ull;
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ull;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebull;
+    hash =  hash ^ (hash >> 31);
+    selected = static_cast<double>(hash >> 11) * (1.0/9007199254740992.0) < fraction;
+    return end!=ranks+7 && fraction>=0.0 && fraction<=1.0;
+  }
+
+  // list of ranks and ranges such as 0,4,8-15
+  selected = false;
+  const char* token = ranks;
+  while (*token!='\0') {
+    char* end;
+    const long first = std::strtol(token, &end, 10);
+    long last = first;
+    if (end==token) {
+      return false;
+    }
+    if (*end=='-') {
+      token = end+1;
+      last  = std::strtol(token, &end, 10);
+      if (end==token) {
+        return false;
+      }
+    }
+    if (first<=rank && rank<=last && rank<numberOfRanks) {
+      selected = true;
+    }
+    if (*end!=',' && *end!='\0') {
+      return false;
+    }
+    token = *end==',' ? end+1 : end;
+  }
+  return true;
+}
+
+
+void dilbert::assertions::selectRank(bool selected) {
+  if (!selected) {
+    switchScopes(0, "Rank not selected");
+  }
+  rankSelected = selected;
+}
+
+
+#ifdef Parallel
+namespace {
+  struct Collective {
+    dilbert::assertions::Site* site;
+    double                     value;
+  };
+
+  std::vector<Collective> pendingCollectives;
+
+  const int CollectivesPerReduction = 32;
+
+  /**
+   * Identifies the site of a record on all ranks: A 32 bit FNV-1a hash of
+   * the file name (the address of the name differs between the ranks)
+   * times 2^21 plus the line. The key thus is an exact double.
+   */
+  double getCollectiveKey(const dilbert::assertions::Site& site) {
+    unsigned int hash = 2166136261u;
+    for (const char* c=site.file; *c!='\0'; c++) {
+      hash = (hash ^ static_cast<unsigned char>(*c)) * 16777619u;
+    }
+    return static_cast<double>(hash) * (1 << 21) + (site.line & ((1 << 21) - 1));
+  }
+
+  DILBERT_COLD void reportCollective(const Collective& collective, int rank, double minimum, double maximum) {
+    dilbert::assertions::reportFailure(collective.site->file, collective.site->line, collective.site->condition,
+      dilbert::assertions::message([&](std::ostream& out) {
+        out << "value on rank " << rank << ": " << collective.value << ", minimum " << minimum << ", maximum " << maximum;
+      }));
+  }
+
+  /**
+   * Each reduction carries the number of pending records followed by the
+   * site key and the value of up to CollectivesPerReduction records. Every
+   * entry x is reduced as x and -x with MPI_MIN, i.e. one reduction yields
+   * the minimum and the maximum over all ranks.
+   */
+  void checkCollectives() {
+    const int Entries = 1 + 2*CollectivesPerReduction;
+    double    send[2*Entries];
+    double    receive[2*Entries];
+
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    const int count = static_cast<int>(pendingCollectives.size());
+    int reductions = 1;
+    for (int reduction=0; reduction<reductions; reduction++) {
+      const int offset = reduction*CollectivesPerReduction;
+      for (int i=0; i<Entries; i++) {
+        const int    record = offset + (i-1) % CollectivesPerReduction;
+        const bool   valid  = i>0 && record<count;
+        const double entry  = i==0                          ? count :
+                              !valid                        ? 0.0 :
+                              i<=CollectivesPerReduction    ? getCollectiveKey(*pendingCollectives[record].site) :
+                                                              pendingCollectives[record].value;
+        send[2*i]   = entry;
+        send[2*i+1] = -entry;
+      }
+      MPI_Allreduce(send, receive, 2*Entries, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
+
+      const int maximumCount = static_cast<int>(-receive[1]);
+      reductions = (maximumCount + CollectivesPerReduction - 1) / CollectivesPerReduction;
+
+      if (receive[0]!=-receive[1]) {
+        printf("Dilbert patches Peano: Rank %d recorded %d collective assertions, but the ranks recorded between %d and %d\n",
+          rank, count, static_cast<int>(receive[0]), maximumCount);
+        assertionTriggersExit;
+      }
+      for (int record=0; record<CollectivesPerReduction && offset+record<count; record++) {
+        const int key   = 1 + record;
+        const int value = 1 + CollectivesPerReduction + record;
+        if (receive[2*key]!=-receive[2*key+1]) {
+          printf("Dilbert patches Peano: Rank %d passed the collective assertion in file %s, line %d, while other ranks passed a different one\n",
+            rank, pendingCollectives[offset+record].site->file, pendingCollectives[offset+record].site->line);
+          assertionTriggersExit;
+        }
+        if (receive[2*value]!=-receive[2*value+1]) {
+          reportCollective(pendingCollectives[offset+record], rank, receive[2*value], -receive[2*value+1]);
+        }
+      }
+    }
+    pendingCollectives.clear();
+  }
+}
+#endif
+
+
+void dilbert::assertions::recordCollective(Site& site, double value) {
+  #ifdef Parallel
+  pendingCollectives.push_back(Collective{&site, value});
+  #else
+  (void)site;
+  (void)value;
+  #endif
+}
+
+
+void dilbert::assertions::onTraversalBoundary() {
+  traversal++;
+  DILBERT_RECORD_EVENT(TraversalBoundary, 0, traversal);
+  #ifdef Parallel
+  if (dilbert_AssertCollectives) {
+    checkCollectives();
+  }
+  #endif
+  if (traversal==windowFirst || traversal==windowEnd) {
+    char reason[64];
+    std::snprintf(reason, sizeof(reason), "Traversal %d %s the assertion window",
+      traversal, traversal==windowFirst ? "starts" : "ends");
+    switchScopes(traversal==windowFirst ? windowScopes : 0, reason);
+  }
+
+  const int signal = pendingSignal;
+  if (signal!=0) {
+    pendingSignal = 0;
+    if (signal==SIGUSR1) {
+      switchScopes(switchedScopes, "SIGUSR1 received");
+    }
+    else {
+      switchScopes(0, "SIGUSR2 received");
+    }
+  }
+
+  unsigned int scopes;
+  if (readControlFile(scopes)) {
+    const std::string reason = "Control file " + controlFile + " has changed";
+    switchScopes(scopes, reason.c_str());
+  }
+}
+
+
+#ifdef Parallel
+namespace {
+  /**
+   * "rank r on host h", formatted by recordOrigin() while MPI may be called.
+   * The failure path and the SIGFPE handler only read it.
+   */
+  char              origin[32+MPI_MAX_PROCESSOR_NAME];
+  int               originRank = 0;
+  std::atomic<bool> originRecorded(false);
+}
+#endif
+
+
+void dilbert::assertions::recordOrigin() {
+  #ifdef Parallel
+  int  rank, length;
+  char host[MPI_MAX_PROCESSOR_NAME];
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Get_processor_name(host, &length);
+  std::snprintf(origin, sizeof(origin), "rank %d on host %s", rank, host);
+  originRank = rank;
+  originRecorded.store(true);
+  #endif
+}
+
+
+void dilbert::assertions::forgetOrigin() {
+  #ifdef Parallel
+  originRecorded.store(false);
+  #endif
+}
+
+
+void dilbert::assertions::printOrigin(Report& out) {
+  #ifdef Parallel
+  if (originRecorded.load()) {
+    out << origin;
+    #ifdef SharedMemoryParallelisation
+    out << ", ";
+    #else
+    out << ": ";
+    #endif
+  }
+  #endif
+
+  #ifdef SharedMemoryParallelisation
+  #ifdef __linux__
+  out << "thread " << syscall(SYS_gettid) << ": ";
+  #else
+  out << "thread " << std::this_thread::get_id() << ": ";
+  #endif
+  #endif
+  (void)out;
+}
+
+
+namespace {
+  std::atomic<bool> failed(false);
+  thread_local bool reporting = false;
+}
+
+
+void dilbert::assertions::latchFirstFailure() {
+  if (reporting) {
+    return;
+  }
+  if (failed.exchange(true)) {
+    for (;;) {
+      pause();
+    }
+  }
+  reporting = true;
+}
+
+
+void dilbert::assertions::abortAllRanks() {
+  #ifdef Parallel
+  int initialised, finalised;
+  MPI_Initialized(&initialised);
+  MPI_Finalized(&finalised);
+  if (initialised && !finalised) {
+    if (dilbert_AssertAbortGrace>0) {
+      sleep(dilbert_AssertAbortGrace);
+    }
+    MPI_Abort(MPI_COMM_WORLD, ASSERTION_EXIT_CODE);
+  }
+  #endif
+  assert(false);
+  exit(ASSERTION_EXIT_CODE);
+}
+
+
+namespace {
+  /**
+   * Unsigned integer of fixed size, just large enough for the exact decimal
+   * expansion of any double: The numerator of a subnormal scaled to one
+   * digit before the point needs about 1140 bits.
+   */
+  struct BigNumber {
+    static const int Limbs = 48;
+    unsigned int     limb[Limbs];
+
+    explicit BigNumber(unsigned long long value) {
+      for (int i=0; i<Limbs; i++) limb[i] = 0;
+      limb[0] = static_cast<unsigned int>(value);
+      limb[1] = static_cast<unsigned int>(value >> 32);
+    }
+
+    void multiply(unsigned int factor) {
+      unsigned long long carry = 0;
+      for (int i=0; i<Limbs; i++) {
+        carry  += static_cast<unsigned long long>(limb[i]) * factor;
+        limb[i] = static_cast<unsigned int>(carry);
+        carry >>= 32;
+      }
+    }
+
+    void multiplyByPowerOfTen(int exponent) {
+      for (; exponent>=9; exponent-=9) multiply(1000000000u);
+      for (; exponent>0;  exponent--)  multiply(10u);
+    }
+
+    void shiftLeft(int bits) {
+      for (; bits>=32; bits-=32) {
+        for (int i=Limbs-1; i>0; i--) limb[i] = limb[i-1];
+        limb[0] = 0;
+      }
+      if (bits>0) {
+        for (int i=Limbs-1; i>0; i--) limb[i] = (limb[i] << bits) | (limb[i-1] >> (32-bits));
+        limb[0] <<= bits;
+      }
+    }
+
+    int compare(const BigNumber& other) const {
+      for (int i=Limbs-1; i>=0; i--) {
+        if (limb[i]!=other.limb[i]) return limb[i]<other.limb[i] ? -1 : 1;
+      }
+      return 0;
+    }
+
+    void subtract(const BigNumber& other) {
+      long long borrow = 0;
+      for (int i=0; i<Limbs; i++) {
+        const long long difference = static_cast<long long>(limb[i]) - other.limb[i] - borrow;
+        limb[i] = static_cast<unsigned int>(difference);
+        borrow  = difference<0 ? 1 : 0;
+      }
+    }
+  };
+
+  int copy(const char* from, char* to) {
+    int length = 0;
+    while (from[length]!='\0') {
+      to[length] = from[length];
+      length++;
+    }
+    return length;
+  }
+
+  /**
+   * copy() for the file prefixes, which come from the environment.
+   */
+  int copyPrefix(const char* from, char* to) {
+    int length = 0;
+    while (from[length]!='\0' && length<dilbert::assertions::MaxFilePrefixLength) {
+      to[length] = from[length];
+      length++;
+    }
+    return length;
+  }
+
+  int formatUnsigned(unsigned long long value, char* text) {
+    char reversed[24];
+    int  length = 0;
+    do {
+      reversed[length++] = static_cast<char>('0' + value % 10);
+      value /= 10;
+    } while (value>0);
+    for (int i=0; i<length; i++) text[i] = reversed[length-1-i];
+    return length;
+  }
+
+  int formatSigned(long long value, char* text) {
+    if (value<0) {
+      text[0] = '-';
+      return 1 + formatUnsigned(0ull - static_cast<unsigned long long>(value), text+1);
+    }
+    return formatUnsigned(static_cast<unsigned long long>(value), text);
+  }
+}
+
+
+int dilbert::assertions::formatScientific(double value, int digits, char* text) {
+  unsigned long long bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const bool         negative = bits >> 63;
+  const int          biased   = static_cast<int>((bits >> 52) & 0x7ff);
+  unsigned long long mantissa = bits & ((1ull << 52) - 1);
+
+  int length = 0;
+  if (negative) {
+    text[length++] = '-';
+  }
+  if (biased==0x7ff) {
+    return length + copy(mantissa==0 ? "inf" : "nan", text+length);
+  }
+
+  // value = mantissa * 2^exponent
+  int exponent = biased==0 ? -1074 : biased - 1075;
+  if (biased!=0) {
+    mantissa |= 1ull << 52;
+  }
+
+  char decimals[32] = {0};
+  int  decimalExponent = 0;
+  if (mantissa==0) {
+    for (int i=0; i<=digits; i++) decimals[i] = 0;
+  }
+  else {
+    // numerator/denominator = value scaled into [1,10)
+    BigNumber numerator(mantissa);
+    BigNumber denominator(1);
+    if (exponent>0) numerator.shiftLeft(exponent);
+    else            denominator.shiftLeft(-exponent);
+
+    // estimate floor(log10(value)) from the bit length, then correct it
+    int bitLength = 0;
+    while ((mantissa >> bitLength)>1) bitLength++;
+    decimalExponent = static_cast<int>((bitLength + exponent) * 0.30102999566398119521);
+    if (decimalExponent>0) denominator.multiplyByPowerOfTen(decimalExponent);
+    else                   numerator.multiplyByPowerOfTen(-decimalExponent);
+
+    BigNumber tenDenominators(denominator);
+    tenDenominators.multiply(10);
+    while (numerator.compare(tenDenominators)>=0) {
+      denominator.multiply(10);
+      tenDenominators.multiply(10);
+      decimalExponent++;
+    }
+    while (numerator.compare(denominator)<0) {
+      numerator.multiply(10);
+      decimalExponent--;
+    }
+
+    for (int i=0; i<=digits; i++) {
+      int digit = 0;
+      while (numerator.compare(denominator)>=0) {
+        numerator.subtract(denominator);
+        digit++;
+      }
+      decimals[i] = static_cast<char>(digit);
+      if (i<digits) numerator.multiply(10);
+    }
+
+    // round half to even as printf does
+    numerator.multiply(2);
+    const int  remainder = numerator.compare(denominator);
+    const bool roundUp   = remainder>0 || (remainder==0 && decimals[digits] % 2==1);
+    for (int i=digits; roundUp && i>=0; i--) {
+      if (decimals[i]<9) {
+        decimals[i]++;
+        break;
+      }
+      decimals[i] = 0;
+      if (i==0) {
+        decimals[0] = 1;
+        decimalExponent++;
+      }
+    }
+  }
+
+  text[length++] = static_cast<char>('0' + decimals[0]);
+  if (digits>0) {
+    text[length++] = '.';
+    for (int i=1; i<=digits; i++) text[length++] = static_cast<char>('0' + decimals[i]);
+  }
+  text[length++] = 'e';
+  text[length++] = decimalExponent<0 ? '-' : '+';
+  const int magnitude = decimalExponent<0 ? -decimalExponent : decimalExponent;
+  if (magnitude<10) {
+    text[length++] = '0';
+  }
+  return length + formatUnsigned(static_cast<unsigned long long>(magnitude), text+length);
+}
+
+
+dilbert::assertions::Report::StreamBuffer::StreamBuffer(Report& report):
+  _report(report) {
+}
+
+
+dilbert::assertions::Report::StreamBuffer::int_type dilbert::assertions::Report::StreamBuffer::overflow(int_type character) {
+  if (!traits_type::eq_int_type(character, traits_type::eof())) {
+    const char text = traits_type::to_char_type(character);
+    _report.append(&text, 1);
+  }
+  return traits_type::not_eof(character);
+}
+
+
+std::streamsize dilbert::assertions::Report::StreamBuffer::xsputn(const char* text, std::streamsize length) {
+  _report.append(text, static_cast<int>(length));
+  return length;
+}
+
+
+dilbert::assertions::Report::Report():
+  _length(0),
+  _streamBuffer(*this),
+  _stream(NULL) {
+}
+
+
+dilbert::assertions::Report::~Report() {
+  flush();
+  if (_stream!=NULL) {
+    _stream->~basic_ostream();
+  }
+}
+
+
+std::ostream& dilbert::assertions::Report::stream() {
+  if (_stream==NULL) {
+    _stream = new (_streamStorage) std::ostream(&_streamBuffer);
+    _stream->setf( std::ios_base::scientific, std::ios_base::floatfield );
+    _stream->precision(20);
+  }
+  return *_stream;
+}
+
+
+void dilbert::assertions::Report::append(const char* text, int length) {
+  while (length>0) {
+    if (_length==Capacity) {
+      flush();
+    }
+    const int chunk = length < Capacity-_length ? length : Capacity-_length;
+    std::memcpy(_buffer+_length, text, chunk);
+    _length += chunk;
+    text    += chunk;
+    length  -= chunk;
+  }
+}
+
+
+void dilbert::assertions::Report::flush() {
+  int written = 0;
+  while (written<_length) {
+    const ssize_t result = ::write(2, _buffer+written, _length-written);
+    if (result<0 && errno!=EINTR) {
+      break;
+    }
+    written += result>0 ? static_cast<int>(result) : 0;
+  }
+  _length = 0;
+}
+
+
+dilbert::assertions::Report& dilbert::assertions::Report::operator<<(const char* text) {
+  append(text, text==NULL ? 0 : static_cast<int>(std::strlen(text)));
+  return *this;
+}
+
+
+dilbert::assertions::Report& dilbert::assertions::Report::operator<<(const std::string& text) {
+  append(text.data(), static_cast<int>(text.size()));
+  return *this;
+}
+
+
+dilbert::assertions::Report& dilbert::assertions::Report::operator<<(char character) {
+  append(&character, 1);
+  return *this;
+}
+
+
+dilbert::assertions::Report& dilbert::assertions::Report::operator<<(bool value) {
+  return *this << (value ? '1' : '0');
+}
+
+
+dilbert::assertions::Report& dilbert::assertions::Report::operator<<(short value) {
+  return *this << static_cast<long long>(value);
+}
+
+
+dilbert::assertions::Report& dilbert::assertions::Report::operator<<(unsigned short value) {
+  return *this << static_cast<unsigned long long>(value);
+}
+
+
+dilbert::assertions::Report& dilbert::assertions::Report::operator<<(int value) {
+  return *this << static_cast<long long>(value);
+}
+
+
+dilbert::assertions::Report& dilbert::assertions::Report::operator<<(unsigned int value) {
+  return *this << static_cast<unsigned long long>(value);
+}
+
+
+dilbert::assertions::Report& dilbert::assertions::Report::operator<<(long value) {
+  return *this << static_cast<long long>(value);
+}
+
+
+dilbert::assertions::Report& dilbert::assertions::Report::operator<<(unsigned long value) {
+  return *this << static_cast<unsigned long long>(value);
+}
+
+
+dilbert::assertions::Report& dilbert::assertions::Report::operator<<(long long value) {
+  char text[24];
+  append(text, formatSigned(value, text));
+  return *this;
+}
+
+
+dilbert::assertions::Report& dilbert::assertions::Report::operator<<(unsigned long long value) {
+  char text[24];
+  append(text, formatUnsigned(value, text));
+  return *this;
+}
+
+
+dilbert::assertions::Report& dilbert::assertions::Report::operator<<(float value) {
+  return *this << static_cast<double>(value);
+}
+
+
+dilbert::assertions::Report& dilbert::assertions::Report::operator<<(double value) {
+  char text[32];
+  append(text, formatScientific(value, 20, text));
+  return *this;
+}
+
+
+dilbert::assertions::Report& dilbert::assertions::Report::operator<<(const void* address) {
+  // as std::ostream does
+  if (address==NULL) {
+    return *this << '0';
+  }
+  char               text[2+2*sizeof(void*)];
+  unsigned long long value  = reinterpret_cast<unsigned long long>(address);
+  int                length = sizeof(text);
+  while (value>0) {
+    text[--length] = "0123456789abcdef"[value & 0xf];
+    value >>= 4;
+  }
+  text[--length] = 'x';
+  text[--length] = '0';
+  append(text+length, static_cast<int>(sizeof(text))-length);
+  return *this;
+}
+
+
+namespace {
+  /**
+   * Sites of MODE=Collect live in an open addressing hash table, i.e. a
+   * thread claims the slot of a new site with one compare and swap and no
+   * lock is needed.
+   */
+  struct ViolationSite {
+    std::atomic<const char*>        file;
+    std::atomic<int>                line;
+    const char*                     expression;
+    std::atomic<unsigned long long> failures;
+  };
+
+  const int ViolationSites = 4096;
+  ViolationSite violationSites[ViolationSites];
+
+  struct ViolationRecord {
+    int                             site;
+    int                             rank;
+    int                             thread;
+    double                          seconds;
+    dilbert::assertions::Violation  violation;
+  };
+
+  /**
+   * Each thread owns one ring buffer. Only the owner writes, and the
+   * buffers are read once all threads are done, i.e. at the shutdown.
+   */
+  struct ViolationRing {
+    static const int                Size = 1024;
+    ViolationRecord                 records[Size];
+    std::atomic<unsigned long long> written;
+    ViolationRing(): written(0) {}
+  };
+
+  std::mutex                                  violationRingsMutex;
+  std::vector<ViolationRing*>                 violationRings;
+  thread_local ViolationRing*                 myViolationRing = NULL;
+  const std::chrono::steady_clock::time_point violationStart  = std::chrono::steady_clock::now();
+
+  int getViolationSite(const char* file, int line, const char* expression) {
+    const unsigned long long hash = (reinterpret_cast<unsigned long long>(file) ^ static_cast<unsigned long long>(line) * 0x9e3779b97f4a7c15ull) * 0xbf58476d1ce4e5b9ull;
+    for (int probe=0; probe<ViolationSites; probe++) {
+      const int   slot = static_cast<int>((hash >> 40) + probe) % ViolationSites;
+      const char* old  = violationSites[slot].file.load(std::memory_order_acquire);
+      if (old==NULL) {
+        if (violationSites[slot].file.compare_exchange_strong(old, file)) {
+          violationSites[slot].expression = expression;
+          violationSites[slot].line.store(line, std::memory_order_release);
+          return slot;
+        }
+      }
+      if (old==file) {
+        // the claiming thread may still write the line
+        int claimedLine;
+        while ((claimedLine=violationSites[slot].line.load(std::memory_order_acquire))==0) {}
+        if (claimedLine==line) {
+          return slot;
+        }
+      }
+    }
+    return -1;
+  }
+
+  int getRank() {
+    #ifdef Parallel
+    return originRank;
+    #else
+    return 0;
+    #endif
+  }
+
+  ViolationRing& getMyViolationRing(int& thread) {
+    static thread_local int myThread = -1;
+    if (myViolationRing==NULL) {
+      myViolationRing = new ViolationRing();
+      std::lock_guard<std::mutex> lock(violationRingsMutex);
+      myThread = static_cast<int>(violationRings.size());
+      violationRings.push_back(myViolationRing);
+    }
+    thread = myThread;
+    return *myViolationRing;
+  }
+}
+
+
+void dilbert::assertions::recordViolation(const char* file, int line, const char* expression, const Violation& violation) {
+  const int site = getViolationSite(file, line, expression);
+  if (site<0) {
+    return;
+  }
+  if (violationSites[site].failures.fetch_add(1, std::memory_order_relaxed)>=dilbert_AssertCollectLimit) {
+    return;
+  }
+
+  int                            thread;
+  ViolationRing&                 ring    = getMyViolationRing(thread);
+  const unsigned long long       written = ring.written.load(std::memory_order_relaxed);
+  ViolationRecord&               record  = ring.records[written % ViolationRing::Size];
+  record.site      = site;
+  record.rank      = getRank();
+  record.thread    = thread;
+  record.seconds   = std::chrono::duration<double>(std::chrono::steady_clock::now() - violationStart).count();
+  record.violation = violation;
+  ring.written.store(written+1, std::memory_order_release);
+}
+
+
+void dilbert::assertions::reportViolations(int rank) {
+  std::vector<int>   sites;
+  unsigned long long failures = 0;
+  for (int site=0; site<ViolationSites; site++) {
+    if (violationSites[site].file.load()!=NULL) {
+      sites.push_back(site);
+      failures += violationSites[site].failures.load();
+    }
+  }
+  std::sort(sites.begin(), sites.end(), [](int a, int b) {
+    return violationSites[a].failures.load() > violationSites[b].failures.load();
+  });
+
+  printf("Dilbert patches Peano: Collected %llu assertion failures at %d sites on rank %d%s\n",
+    failures, static_cast<int>(sites.size()), rank, sites.empty() ? "" : ", most frequent first:");
+  std::lock_guard<std::mutex> lock(violationRingsMutex);
+  for (unsigned int i=0; i<sites.size(); i++) {
+    const ViolationSite& site = violationSites[sites[i]];
+    printf("  %12llu failures  %s:%d: %s\n", site.failures.load(), site.file.load(), site.line.load(), site.expression);
+
+    for (unsigned int thread=0; thread<violationRings.size(); thread++) {
+      const ViolationRing&     ring    = *violationRings[thread];
+      const unsigned long long written = ring.written.load(std::memory_order_acquire);
+      const unsigned long long first   = written>ViolationRing::Size ? written-ViolationRing::Size : 0;
+      for (unsigned long long entry=first; entry<written; entry++) {
+        const ViolationRecord& record = ring.records[entry % ViolationRing::Size];
+        if (record.site==sites[i]) {
+          printf("      at %.6fs on rank %d, thread %d", record.seconds, record.rank, record.thread);
+          for (int value=0; value<record.violation.numberOfValues; value++) {
+            printf("%s%.17g", value==0 ? ", values " : " ", record.violation.values[value]);
+          }
+          printf("\n");
+        }
+      }
+    }
+  }
+}
+
+
+namespace {
+  std::mutex                                flightRingsMutex;
+  std::vector<dilbert::assertions::FlightRing*> flightRings;
+  double                                    flightClockFrequency = 1e9;
+
+  /**
+   * Header of the flight recorder file, followed by the rings (number of
+   * the thread, number of events, events from the oldest to the newest) and
+   * the backtrace as text.
+   */
+  struct FlightHeader {
+    char               magic[8];
+    unsigned int       version;
+    unsigned int       threads;
+    unsigned int       failingThread;
+    int                rank;
+    double             clockFrequency;
+    unsigned long long failureTime;
+    int                line;
+    char               file[252];
+  };
+
+  void writeAll(int descriptor, const void* data, size_t length) {
+    const char* bytes = static_cast<const char*>(data);
+    while (length>0) {
+      const ssize_t result = ::write(descriptor, bytes, length);
+      if (result<0 && errno==EINTR) {
+        continue;
+      }
+      if (result<=0) {
+        return;
+      }
+      bytes  += result;
+      length -= static_cast<size_t>(result);
+    }
+  }
+}
+
+
+dilbert::assertions::FlightRing* dilbert::assertions::registerFlightRing() {
+  FlightRing* ring = new FlightRing();
+  ring->written = 0;
+  std::lock_guard<std::mutex> lock(flightRingsMutex);
+  flightRings.push_back(ring);
+  FlightRecorder<0>::ring = ring;
+  return ring;
+}
+
+
+void dilbert::assertions::installFlightRecorder() {
+  const unsigned long long                    ticks = readFlightClock();
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  std::chrono::duration<double>               elapsed(0.0);
+  while (elapsed.count()<0.01) {
+    elapsed = std::chrono::steady_clock::now() - start;
+  }
+  flightClockFrequency = (readFlightClock() - ticks) / elapsed.count();
+  registerFlightRing();
+}
+
+
+void dilbert::assertions::dumpFlightRecorder(const char* file, int line) {
+  recordFlightEvent(AssertionFailure, 0, static_cast<unsigned long long>(line));
+
+  const int rank = getRank();
+  char      fileName[512];
+  int       length = copyPrefix(dilbert_FlightRecorder, fileName);
+  length += copy("-rank", fileName+length);
+  length += formatUnsigned(static_cast<unsigned long long>(rank), fileName+length);
+  copy(".bin", fileName+length);
+  fileName[length+4] = '\0';
+
+  const int descriptor = ::open(fileName, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (descriptor<0) {
+    Report out;
+    out << "Dilbert patches Peano: Cannot write flight recorder to " << fileName << '\n';
+    return;
+  }
+
+  // no lock, as a thread might have failed while registering
+  FlightHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, "DILBFR1", 8);
+  header.version        = 1;
+  header.threads        = static_cast<unsigned int>(flightRings.size());
+  header.failingThread  = 0;
+  header.rank           = rank;
+  header.clockFrequency = flightClockFrequency;
+  header.failureTime    = readFlightClock();
+  header.line           = line;
+  std::strncpy(header.file, file, sizeof(header.file)-1);
+  for (unsigned int thread=0; thread<flightRings.size(); thread++) {
+    if (flightRings[thread]==FlightRecorder<0>::ring) header.failingThread = thread;
+  }
+  writeAll(descriptor, &header, sizeof(header));
+
+  for (unsigned int thread=0; thread<flightRings.size(); thread++) {
+    const FlightRing&        ring    = *flightRings[thread];
+    const unsigned long long written = ring.written;
+    const unsigned long long events  = written<FlightRing::Size ? written : FlightRing::Size;
+    const unsigned long long oldest  = (written - events) % FlightRing::Size;
+    const unsigned long long counts[2] = {thread, events};
+    writeAll(descriptor, counts, sizeof(counts));
+    const unsigned long long first = oldest + events <= FlightRing::Size ? events : FlightRing::Size - oldest;
+    writeAll(descriptor, ring.records + oldest, first * sizeof(FlightRecord));
+    writeAll(descriptor, ring.records, (events-first) * sizeof(FlightRecord));
+  }
+
+  void*     frames[64];
+  const int depth = backtrace(frames, 64);
+  backtrace_symbols_fd(frames, depth, descriptor);
+  ::close(descriptor);
+
+  Report out;
+  out << "Dilbert patches Peano: Flight recorder written to " << fileName << " (see decode-flight-recorder.py)\n";
+}
+
+
+namespace {
+  struct CheckpointHookEntry {
+    dilbert::assertions::CheckpointHook hook;
+    void*                               data;
+  };
+
+  CheckpointHookEntry checkpointHooks[dilbert::assertions::MaxCheckpointHooks];
+  std::atomic<int>    numberOfCheckpointHooks(0);
+  std::atomic<bool>   checkpointed(false);
+
+  void handleTermination(int signal) {
+    dilbert::assertions::runCheckpointHooks(signal==SIGABRT ? "SIGABRT" : "SIGTERM");
+
+    // terminate as without the handler, e.g. with a core dump for SIGABRT
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = SIG_DFL;
+    sigemptyset(&action.sa_mask);
+    sigaction(signal, &action, NULL);
+    raise(signal);
+  }
+}
+
+
+bool dilbert::assertions::addCheckpointHook(CheckpointHook hook, void* data) {
+  const int hooks = numberOfCheckpointHooks.load();
+  if (hooks>=MaxCheckpointHooks) {
+    return false;
+  }
+  checkpointHooks[hooks].hook = hook;
+  checkpointHooks[hooks].data = data;
+  numberOfCheckpointHooks.store(hooks+1);
+
+  if (hooks==0) {
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_handler = handleTermination;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGABRT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+  }
+  return true;
+}
+
+
+void dilbert::assertions::runCheckpointHooks(const char* reason) {
+  const int hooks = numberOfCheckpointHooks.load();
+  if (hooks==0 || checkpointed.exchange(true)) {
+    return;
+  }
+  const int rank = getRank();
+  for (int i=0; i<hooks; i++) {
+    checkpointHooks[i].hook(rank, reason, checkpointHooks[i].data);
+  }
+}
+
+
+void dilbert::assertions::runCheckpointHooks(const char* file, int line) {
+  if (numberOfCheckpointHooks.load()==0) {
+    return;
+  }
+  char reason[512];
+  int  length = copy("assertion in file ", reason);
+  for (const char* c=file; *c!='\0' && length<static_cast<int>(sizeof(reason))-40; c++) {
+    reason[length++] = *c;
+  }
+  length += copy(", line ", reason+length);
+  length += formatSigned(line, reason+length);
+  reason[length] = '\0';
+  runCheckpointHooks(reason);
+}
+
+
+bool dilbert::assertions::writeCheckpoint(const char* prefix, int rank, const struct iovec* buffers, int count) {
+  char fileName[512];
+  char temporaryName[512];
+  int  length = copyPrefix(prefix, fileName);
+  length += copy("-rank", fileName+length);
+  length += formatUnsigned(static_cast<unsigned long long>(rank), fileName+length);
+  length += copy(".chk", fileName+length);
+  fileName[length] = '\0';
+  std::memcpy(temporaryName, fileName, length);
+  copy(".tmp", temporaryName+length);
+  temporaryName[length+4] = '\0';
+
+  const int descriptor = ::open(temporaryName, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (descriptor<0) {
+    return false;
+  }
+
+  // writev may write less than requested, and takes at most IOV_MAX buffers
+  const int    MaxBuffers = 64;
+  struct iovec pending[MaxBuffers];
+  bool         success = true;
+  for (int first=0; first<count && success; first+=MaxBuffers) {
+    int chunk = count-first < MaxBuffers ? count-first : MaxBuffers;
+    std::memcpy(pending, buffers+first, chunk*sizeof(struct iovec));
+    struct iovec* next = pending;
+    while (chunk>0) {
+      ssize_t written = ::writev(descriptor, next, chunk);
+      if (written<0 && errno==EINTR) {
+        continue;
+      }
+      if (written<0) {
+        success = false;
+        break;
+      }
+      while (chunk>0 && static_cast<size_t>(written)>=next->iov_len) {
+        written -= static_cast<ssize_t>(next->iov_len);
+        next++;
+        chunk--;
+      }
+      if (chunk>0) {
+        next->iov_base  = static_cast<char*>(next->iov_base) + written;
+        next->iov_len  -= static_cast<size_t>(written);
+      }
+    }
+  }
+
+  success = ::fsync(descriptor)==0 && success;
+  success = ::close(descriptor)==0 && success;
+  return success && ::rename(temporaryName, fileName)==0;
+}
+
+
+#if defined(SharedTBB)
+#include <tbb/task_scheduler_observer.h>
+#endif
+
+#if defined(SharedOMP)
+#include <omp.h>
+#endif
+
+namespace {
+  const char* getFloatingPointExceptionName(int code) {
+    switch (code) {
+      case FPE_FLTINV: return "invalid operation";
+      case FPE_FLTDIV: return "division by zero";
+      case FPE_FLTOVF: return "overflow";
+      case FPE_FLTUND: return "underflow";
+      case FPE_FLTRES: return "inexact result";
+      case FPE_INTDIV: return "integer division by zero";
+      case FPE_INTOVF: return "integer overflow";
+      default:         return "unknown cause";
+    }
+  }
+
+  /**
+   * Ends the run from the SIGFPE handler. Unlike abortAllRanks(), it neither
+   * asks MPI whether it is running nor calls exit(), which runs the atexit
+   * handlers and flushes stdio.
+   */
+  [[noreturn]] void abortFromSignal() {
+    #ifdef Parallel
+    if (originRecorded.load()) {
+      if (dilbert_AssertAbortGrace>0) {
+        sleep(dilbert_AssertAbortGrace);
+      }
+      MPI_Abort(MPI_COMM_WORLD, ASSERTION_EXIT_CODE);
+    }
+    #endif
+    _exit(ASSERTION_EXIT_CODE);
+  }
+
+  /**
+   * Sticks to async-signal-safe calls (but MPI_Abort): The message goes
+   * through the fixed buffer of Report and write(2), the origin has been
+   * formatted by recordOrigin() and backtrace() has been loaded by
+   * enableFloatingPointTraps(). Hence, stdout is not flushed.
+   */
+  void handleFloatingPointException(int, siginfo_t* info, void*) {
+    dilbert::assertions::latchFirstFailure();
+    {
+      dilbert::assertions::Report out;
+      dilbert::assertions::printOrigin(out);
+      out << "floating point exception at address " << static_cast<const void*>(info->si_addr)
+          << " failed: " << getFloatingPointExceptionName(info->si_code) << '\n';
+      out.flush();
+      void*     frames[32];
+      const int depth = backtrace(frames, 32);
+      backtrace_symbols_fd(frames, depth, 2);
+    }
+    if (dilbert_FlightRecorder!=NULL) {
+      dilbert::assertions::dumpFlightRecorder("SIGFPE", 0);
+    }
+    dilbert::assertions::runCheckpointHooks("floating point exception");
+    abortFromSignal();
+  }
+
+  void enableTrapsOnThisThread() {
+    #if defined(__GLIBC__)
+    feclearexcept(FE_ALL_EXCEPT);
+    feenableexcept(dilbert_FloatingPointTraps);
+    #endif
+  }
+
+  #if defined(SharedTBB)
+  class FloatingPointTrapObserver: public tbb::task_scheduler_observer {
+    public:
+      FloatingPointTrapObserver() {
+        observe(true);
+      }
+      void on_scheduler_entry(bool) override {
+        enableTrapsOnThisThread();
+      }
+  };
+  #endif
+}
+
+
+int dilbert::assertions::parseFloatingPointTraps(const char* traps) {
+  static const char* Names[] = {"invalid", "divbyzero", "overflow", "underflow", "inexact"};
+  static const int   Flags[] = {FE_INVALID, FE_DIVBYZERO, FE_OVERFLOW, FE_UNDERFLOW, FE_INEXACT};
+
+  int         result = 0;
+  const char* token  = traps;
+  while (*token!='\0') {
+    const size_t length = std::strcspn(token, ",");
+    bool         found  = length==3 && strncasecmp(token, "all", 3)==0;
+    if (found) {
+      result = FE_ALL_EXCEPT;
+    }
+    for (int i=0; i<5; i++) {
+      if (length==std::strlen(Names[i]) && strncasecmp(token, Names[i], length)==0) {
+        result |= Flags[i];
+        found   = true;
+      }
+    }
+    if (!found && length>0) {
+      return -1;
+    }
+    token += length;
+    if (*token==',') token++;
+  }
+  return result;
+}
+
+
+void dilbert::assertions::enableFloatingPointTraps() {
+  struct sigaction action;
+  std::memset(&action, 0, sizeof(action));
+  action.sa_sigaction = handleFloatingPointException;
+  action.sa_flags     = SA_SIGINFO;
+  sigemptyset(&action.sa_mask);
+  sigaction(SIGFPE, &action, NULL);
+
+  // the first backtrace() loads libgcc, which allocates
+  void* frame;
+  backtrace(&frame, 1);
+
+  enableTrapsOnThisThread();
+
+  #if defined(SharedOMP)
+  #pragma omp parallel
+  {
+    enableTrapsOnThisThread();
+  }
+  #endif
+
+  #if defined(SharedTBB)
+  static FloatingPointTrapObserver observer;
+  #endif
+}
+
+
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__INTEL_COMPILER)
+#define DILBERT_BULK_SIMD
+#endif
+
+namespace {
+  enum BulkKernel {
+    Scalar = 0,
+    AVX2,
+    AVX512
+  };
+
+  /**
+   * A check provides the scalar predicate of entry i and the lane masks of
+   * the four (AVX2) or eight (AVX-512) entries starting at i. The drivers
+   * below test 16 or 32 entries per branch and search the first failing
+   * entry of a block only if it fails.
+   */
+  struct IsFinite {
+    const double* data;
+
+    bool scalar(int i) const {
+      return std::fabs(data[i])<=DBL_MAX;
+    }
+
+    #ifdef DILBERT_BULK_SIMD
+    __attribute__((target("avx2"))) __m256d avx2(int i) const {
+      const __m256d absolute = _mm256_andnot_pd(_mm256_set1_pd(-0.0), _mm256_loadu_pd(data+i));
+      return _mm256_cmp_pd(absolute, _mm256_set1_pd(DBL_MAX), _CMP_LE_OQ);
+    }
+
+    __attribute__((target("avx512f"))) __mmask8 avx512(int i) const {
+      return _mm512_cmp_pd_mask(_mm512_abs_pd(_mm512_loadu_pd(data+i)), _mm512_set1_pd(DBL_MAX), _CMP_LE_OQ);
+    }
+    #endif
+  };
+
+  struct IsInRange {
+    const double* data;
+    double        lower;
+    double        upper;
+
+    bool scalar(int i) const {
+      return lower<=data[i] && data[i]<=upper;
+    }
+
+    #ifdef DILBERT_BULK_SIMD
+    __attribute__((target("avx2"))) __m256d avx2(int i) const {
+      const __m256d value = _mm256_loadu_pd(data+i);
+      return _mm256_and_pd(_mm256_cmp_pd(value, _mm256_set1_pd(lower), _CMP_GE_OQ), _mm256_cmp_pd(value, _mm256_set1_pd(upper), _CMP_LE_OQ));
+    }
+
+    __attribute__((target("avx512f"))) __mmask8 avx512(int i) const {
+      const __m512d value = _mm512_loadu_pd(data+i);
+      return _mm512_cmp_pd_mask(value, _mm512_set1_pd(lower), _CMP_GE_OQ) & _mm512_cmp_pd_mask(value, _mm512_set1_pd(upper), _CMP_LE_OQ);
+    }
+    #endif
+  };
+
+  struct IsNumericallyEqual {
+    const double* lhs;
+    const double* rhs;
+    double        tolerance;
+
+    bool scalar(int i) const {
+      return std::fabs(lhs[i]-rhs[i])<=tolerance;
+    }
+
+    #ifdef DILBERT_BULK_SIMD
+    __attribute__((target("avx2"))) __m256d avx2(int i) const {
+      const __m256d difference = _mm256_sub_pd(_mm256_loadu_pd(lhs+i), _mm256_loadu_pd(rhs+i));
+      return _mm256_cmp_pd(_mm256_andnot_pd(_mm256_set1_pd(-0.0), difference), _mm256_set1_pd(tolerance), _CMP_LE_OQ);
+    }
+
+    __attribute__((target("avx512f"))) __mmask8 avx512(int i) const {
+      const __m512d difference = _mm512_sub_pd(_mm512_loadu_pd(lhs+i), _mm512_loadu_pd(rhs+i));
+      return _mm512_cmp_pd_mask(_mm512_abs_pd(difference), _mm512_set1_pd(tolerance), _CMP_LE_OQ);
+    }
+    #endif
+  };
+
+  template <typename Check>
+  int findFirstScalar(const Check& check, int first, int last) {
+    for (int i=first; i<last; i++) {
+      if (!check.scalar(i)) return i;
+    }
+    return -1;
+  }
+
+  #ifdef DILBERT_BULK_SIMD
+  template <typename Check>
+  __attribute__((target("avx2"))) int findFirstAVX2(const Check& check, int n) {
+    int i = 0;
+    for (; i+16<=n; i+=16) {
+      const __m256d valid = _mm256_and_pd(
+        _mm256_and_pd(check.avx2(i),   check.avx2(i+4)),
+        _mm256_and_pd(check.avx2(i+8), check.avx2(i+12)));
+      if (DILBERT_UNLIKELY(_mm256_movemask_pd(valid)!=0xf)) {
+        return findFirstScalar(check, i, i+16);
+      }
+    }
+    return findFirstScalar(check, i, n);
+  }
+
+  template <typename Check>
+  __attribute__((target("avx512f"))) int findFirstAVX512(const Check& check, int n) {
+    int i = 0;
+    for (; i+32<=n; i+=32) {
+      const __mmask8 valid = check.avx512(i) & check.avx512(i+8) & check.avx512(i+16) & check.avx512(i+24);
+      if (DILBERT_UNLIKELY(valid!=0xff)) {
+        return findFirstScalar(check, i, i+32);
+      }
+    }
+    return findFirstScalar(check, i, n);
+  }
+  #endif
+
+  int selectBulkKernel() {
+    #ifdef DILBERT_BULK_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return AVX512;
+    if (__builtin_cpu_supports("avx2"))    return AVX2;
+    #endif
+    return Scalar;
+  }
+
+  // before the static initialisation, the scalar kernels are used
+  const int bulkKernel = selectBulkKernel();
+
+  template <typename Check>
+  int findFirst(const Check& check, int n) {
+    #ifdef DILBERT_BULK_SIMD
+    switch (bulkKernel) {
+      case AVX512: return findFirstAVX512(check, n);
+      case AVX2:   return findFirstAVX2(check, n);
+    }
+    #endif
+    return findFirstScalar(check, 0, n);
+  }
+}
+
+
+int dilbert::assertions::findNonFinite(const double* data, int n) {
+  return findFirst(IsFinite{data}, n);
+}
+
+
+int dilbert::assertions::findOutOfRange(const double* data, int n, double lower, double upper) {
+  return findFirst(IsInRange{data, lower, upper}, n);
+}
+
+
+int dilbert::assertions::findNumericalDifference(const double* lhs, const double* rhs, int n, double tolerance) {
+  return findFirst(IsNumericallyEqual{lhs, rhs, tolerance}, n);
+}
+
+
+const char* dilbert::assertions::getBulkKernelName() {
+  return bulkKernel==AVX512 ? "avx512" : bulkKernel==AVX2 ? "avx2" : "scalar";
+}
+
+
+bool dilbert::assertions::parseNumericalTolerance(const char* tolerance, double& absolute, double& relative, long long& ulps) {
+  double    newAbsolute = 0.0;
+  double    newRelative = 0.0;
+  long long newUlps     = 0;
+
+  const char* token = tolerance;
+  do {
+    const bool  prefixed = std::strncmp(token, "abs:", 4)==0 || std::strncmp(token, "rel:", 4)==0 || std::strncmp(token, "ulp:", 4)==0;
+    const char* value    = prefixed ? token+4 : token;
+    char*       end;
+    if (token[0]=='r') {
+      newRelative = std::strtod(value, &end);
+    } else if (token[0]=='u') {
+      newUlps = std::strtoll(value, &end, 10);
+    } else {
+      newAbsolute = std::strtod(value, &end);
+    }
+    if (end==value || (*end!='\0' && *end!=',') || newAbsolute<0.0 || newRelative<0.0 || newUlps<0) {
+      return false;
+    }
+    token = *end==',' ? end+1 : end;
+  } while (*token!='\0');
+
+  absolute = newAbsolute;
+  relative = newRelative;
+  ulps     = newUlps;
+  return true;
+}
+
+
+void dilbert::assertions::setNumericalTolerance(double absolute, double relative, long long ulps) {
+  dilbert_AssertAbsoluteTolerance = absolute;
+  dilbert_AssertRelativeTolerance = relative;
+  dilbert_AssertUlpTolerance      = ulps;
+}
+
+
+dilbert::assertions::NumericalDifference dilbert::assertions::locateNumericalDifference(const double* lhs, const double* rhs, int n) {
+  for (int i=0; i<n; i++) {
+    if (!isNumericallyEqual(lhs[i], rhs[i], dilbert_AssertAbsoluteTolerance, dilbert_AssertRelativeTolerance, dilbert_AssertUlpTolerance)) {
+      return NumericalDifference{i, n, lhs[i], rhs[i]};
+    }
+  }
+  return NumericalDifference{-1, n, 0.0, 0.0};
+}
+
+
+void dilbert::assertions::print(Report& out, const NumericalDifference& item) {
+  if (item.components>1) {
+    out << "first differing component " << item.index << ": " << item.lhs << " vs " << item.rhs << '\n';
+  }
+  const double difference = std::abs(item.lhs-item.rhs);
+  const double magnitude  = std::max(std::abs(item.lhs), std::abs(item.rhs));
+  out << "difference " << difference
+      << ", relative " << (magnitude>0.0 ? difference/magnitude : 0.0)
+      << ", ulps " << getUlpDistance(item.lhs, item.rhs)
+      << " (tolerance " << dilbert_AssertAbsoluteTolerance
+      << ", relative " << dilbert_AssertRelativeTolerance
+      << ", ulps " << dilbert_AssertUlpTolerance << ")\n";
+}
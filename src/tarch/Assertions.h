@@ -16,7 +16,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <cassert>
+#include <cmath>
 #include <cstdio>
+#include <cstring>
+#include <limits>
+#include <atomic>
+#include <chrono>
+#include <sys/uio.h>
 
   /**
    * Make the check for assertions something which is always built in but only
@@ -33,7 +39,915 @@
    *
    **/
   extern bool dilbert_Asserts; // stored in peano/peano.cpp
-  #define DILBERT_PEANO_IF_ASSERTION(cond) if (dilbert_Asserts && (cond))
+
+  /**
+   * Non-fatal mode, switched on via
+   *
+   *   export MODE=Collect
+   *   export DILBERT_ASSERT_COLLECT_LIMIT=10   Occurrences kept per site
+   *
+   * Failed assertions are recorded and the run continues. A summary of all
+   * failures is plotted at peano::shutdownParallelEnvironment().
+   **/
+  extern bool dilbert_AssertCollect; // stored in peano/peano.cpp
+  extern unsigned int dilbert_AssertCollectLimit; // stored in peano/peano.cpp
+
+  /**
+   * Assertions are grouped into scopes (see dilbert::assertions::Scope), and
+   * each scope can be switched on separately, e.g. via
+   *
+   *   export DILBERT_ASSERT_SCOPES=heap,parallel
+   *
+   * Bit i of the mask is set if the assertions of scope i are checked.
+   * dilbert_Asserts is true if any scope is switched on.
+   **/
+  extern unsigned int dilbert_AssertScopes; // stored in peano/peano.cpp
+
+  /**
+   * Each assertion is classified by its cost (see dilbert::assertions::Cost)
+   * and only assertions up to this cost are checked, e.g. via
+   *
+   *   export DILBERT_ASSERT_LEVEL=cheap
+   *
+   * By default, all assertions are checked.
+   **/
+  extern int dilbert_AssertCost; // stored in peano/peano.cpp
+
+  /**
+   * For long runs, each assertion site can evaluate its condition only
+   * every n-th time it is reached, e.g. via
+   *
+   *   export DILBERT_ASSERT_SAMPLE=1000
+   *
+   * The default of 1 checks every evaluation.
+   **/
+  extern unsigned int dilbert_AssertSample; // stored in peano/peano.cpp
+
+  /**
+   * Per-site statistics (see dilbert::assertions::Statistics), switched on
+   * via
+   *
+   *   export DILBERT_ASSERT_STATS=counts       Count evaluations per site
+   *   export DILBERT_ASSERT_STATS=cycles       Also measure their cost (rdtsc)
+   *   export DILBERT_ASSERT_STATS_FILE=a.csv   Write all sites as CSV
+   *
+   * The most expensive sites are reported at
+   * peano::shutdownParallelEnvironment().
+   **/
+  extern int dilbert_AssertStatistics; // stored in peano/peano.cpp
+
+  /**
+   * Upper bound for the runtime share spent in assertions in percent, e.g.
+   *
+   *   export DILBERT_ASSERT_BUDGET=5
+   *
+   * If the checks exceed the budget, the most expensive sites are checked
+   * less often and finally switched off. 0 (the default) means no budget.
+   * A budget implies DILBERT_ASSERT_STATS=cycles.
+   **/
+  extern double dilbert_AssertBudget; // stored in peano/peano.cpp
+
+  /**
+   * Collective assertions such as assertionAllRanksEqual() are checked if
+   * the parallel scope is switched on at startup. Unlike the other
+   * switches, this one is the same on all ranks for the whole run, as all
+   * ranks have to take part in the reduction.
+   **/
+  extern bool dilbert_AssertCollectives; // stored in peano/peano.cpp
+
+  /**
+   * With MPI, a failing assertion stops the whole job via MPI_Abort. Before,
+   * the failing rank waits the given number of seconds, e.g.
+   *
+   *   export DILBERT_ASSERT_ABORT_GRACE=5
+   *
+   * such that other ranks which fail at the same time can print their first
+   * failure, too. The default of 0 aborts immediately.
+   **/
+  extern int dilbert_AssertAbortGrace; // stored in peano/peano.cpp
+
+  /**
+   * Flight recorder (see dilbert::assertions::recordFlightEvent()), switched
+   * on via
+   *
+   *   export DILBERT_FLIGHT_RECORDER=flight
+   *
+   * A failing assertion then writes the recent events of all threads and a
+   * backtrace to flight-rank<r>.bin. NULL if switched off.
+   **/
+  extern const char* dilbert_FlightRecorder; // stored in peano/peano.cpp
+
+  /**
+   * Floating point exceptions which trap (FE_INVALID etc.), e.g. via
+   *
+   *   export DILBERT_FPE=invalid,divbyzero,overflow
+   *   export MODE=FPTrap                          Same, without assertions
+   *
+   * A trapping operation raises SIGFPE, which is reported like a failing
+   * assertion. The checks thus cost nothing per operation. 0 if off.
+   **/
+  extern int dilbert_FloatingPointTraps; // stored in peano/peano.cpp
+
+  /**
+   * Tolerances of assertionNumericalEquals() and its vector and matrix
+   * variants, e.g.
+   *
+   *   export DILBERT_ASSERT_TOLERANCE=1e-10             Absolute
+   *   export DILBERT_ASSERT_TOLERANCE=rel:1e-12         Relative to the larger magnitude
+   *   export DILBERT_ASSERT_TOLERANCE=ulp:4             Units in the last place
+   *   export DILBERT_ASSERT_TOLERANCE=1e-14,rel:1e-12   Any combination
+   *
+   * Two values are equal if any of the given tolerances holds. By default,
+   * the absolute tolerance is tarch::la::NUMERICAL_ZERO_DIFFERENCE as in
+   * tarch::la::equals(), and the others are 0 (off). The tolerances can be
+   * changed at runtime via dilbert::assertions::setNumericalTolerance().
+   **/
+  extern double    dilbert_AssertAbsoluteTolerance; // stored in peano/peano.cpp
+  extern double    dilbert_AssertRelativeTolerance; // stored in peano/peano.cpp
+  extern long long dilbert_AssertUlpTolerance; // stored in peano/peano.cpp
+
+  /**
+   * Hints for the compiler which keep the assertion checks cheap: The
+   * condition is expected to be false and the failure path is moved out of
+   * the kernel into a function which lives in the cold text section.
+   **/
+  #if defined(__GNUC__)
+  #define DILBERT_UNLIKELY(cond) __builtin_expect(!!(cond), 0)
+  #define DILBERT_COLD [[gnu::cold, gnu::noinline]]
+  #else
+  #define DILBERT_UNLIKELY(cond) (cond)
+  #define DILBERT_COLD
+  #endif
+
+  /**
+   * Tells the optimiser that cond holds, without checking it. cond is never
+   * evaluated: clang's __builtin_assume discards it. For GCC, the comma
+   * expression ((void)cond,0) is a constant only if cond has no side
+   * effects (the cast keeps -Wunused-value quiet at every site), and
+   * only then the assumption is emitted. Conditions with calls (unless they
+   * are inlined into side-effect free code) thus yield no assumption.
+   **/
+  #if defined(__clang__)
+  #define DILBERT_ASSUME(cond) __builtin_assume(cond)
+  #elif defined(__GNUC__)
+  #define DILBERT_ASSUME(cond) (__builtin_constant_p(((void)(cond), 0)) ? ((cond) ? (void)0 : __builtin_unreachable()) : (void)0)
+  #else
+  #define DILBERT_ASSUME(cond) ((void)0)
+  #endif
+
+  /**
+   * Static branches: Instead of loading dilbert_Asserts at every assertion
+   * site, each site is compiled into a five byte NOP (asm goto) and its
+   * address is stored in the section dilbert_static_branches. Once the mode
+   * is known, peano::initParallelEnvironment() rewrites the NOPs into jumps
+   * to the checking code if assertions are switched on. A switched off
+   * assertion thus costs a single NOP.
+   *
+   * The entries are emitted with the section flag "?", i.e. into the COMDAT
+   * group of the function holding the assertion. If the linker discards
+   * the duplicate of an inline or template function, it discards its
+   * entries, too.
+   *
+   * The mechanism is available for GCC/clang on x86_64 Linux. Everywhere
+   * else, or if you compile with -DDILBERT_NO_STATIC_BRANCHES, the branch
+   * falls back to the plain check of dilbert_AssertScopes and
+   * dilbert_AssertCost.
+   **/
+  #if !defined(DILBERT_NO_STATIC_BRANCHES) && defined(__GNUC__) && defined(__x86_64__) && defined(__linux__) && !defined(__INTEL_COMPILER) && (!defined(__clang__) || __clang_major__ >= 13)
+  #define DILBERT_STATIC_BRANCHES
+  #endif
+
+  namespace dilbert {
+    namespace assertions {
+      /**
+       * The scope of an assertion site is derived at compile time from the
+       * path of the file it is written in. Files which do not belong to
+       * Peano's kernel count as User. A file can override the derived scope
+       * by defining DILBERT_ASSERTION_SCOPE before it includes this header,
+       * e.g.
+       *
+       * \code
+       * #define DILBERT_ASSERTION_SCOPE ::dilbert::assertions::Heap
+       * \endcode
+       */
+      enum Scope {
+        LinearAlgebra = 0, // tarch/la
+        Grid,              // peano/grid
+        Heap,              // peano/heap
+        Communication,     // tarch/parallel, peano/parallel, tarch/mpianalysis (not Parallel, which is Peano's MPI build flag)
+        Kernel,            // any other part of tarch and peano
+        User,              // the solver/application
+        NumberOfScopes
+      };
+
+      constexpr bool startsWith(const char* text, const char* prefix) {
+        return *prefix=='\0' || (*text==*prefix && startsWith(text+1, prefix+1));
+      }
+
+      constexpr bool contains(const char* text, const char* pattern) {
+        return startsWith(text, pattern) || (*text!='\0' && contains(text+1, pattern));
+      }
+
+      constexpr int getScope(const char* file) {
+        return contains(file, "tarch/la/")          ? LinearAlgebra :
+               contains(file, "peano/grid/")        ? Grid :
+               contains(file, "peano/heap/")        ? Heap :
+               contains(file, "tarch/parallel/")    ? Communication :
+               contains(file, "peano/parallel/")    ? Communication :
+               contains(file, "tarch/mpianalysis/") ? Communication :
+               contains(file, "tarch/")             ? Kernel :
+               contains(file, "peano/")             ? Kernel :
+                                                      User;
+      }
+
+      /**
+       * Translates a comma separated list of scope names such as
+       * "heap,parallel" into a bit mask. Besides the scope names la, grid,
+       * heap, parallel, kernel and user, all and none are accepted.
+       */
+      unsigned int parseScopes(const char* scopes);
+
+      const char* getScopeName(int scope);
+
+      /**
+       * Cost classes of assertions. Plain assertions are Normal, the vector
+       * assertions are Expensive. A block or function can reclassify all
+       * the assertions it contains via DILBERT_ASSERTION_COST, e.g.
+       *
+       * \code
+       * void Heap::validate() {
+       *   DILBERT_ASSERTION_COST(::dilbert::assertions::Paranoid);
+       *   ...
+       * }
+       * \endcode
+       *
+       * For single assertions, there are assertionCheap(), assertionExpensive()
+       * and assertionParanoid().
+       */
+      enum Cost {
+        Cheap = 0,
+        Normal,
+        Expensive,
+        Paranoid,
+        NumberOfCosts
+      };
+
+      /**
+       * Returns the cost for a name such as "cheap" or -1 if the name is not
+       * known.
+       */
+      int parseCost(const char* cost);
+
+      const char* getCostName(int cost);
+
+      /**
+       * Every combination of scope and cost has a switch of its own.
+       */
+      constexpr int getKey(int scope, int cost) {
+        return scope * NumberOfCosts + cost;
+      }
+
+      /**
+       * Sampling has a switch of its own behind all the scope/cost keys.
+       * Without sampling, an active assertion thus pays only one more NOP.
+       */
+      constexpr int SamplingKey = NumberOfScopes * NumberOfCosts;
+
+      /**
+       * Same for the statistics.
+       */
+      constexpr int StatisticsKey = SamplingKey + 1;
+
+      /**
+       * Same for the collective assertions.
+       */
+      constexpr int CollectiveKey = StatisticsKey + 1;
+
+      /**
+       * Same for the flight recorder.
+       */
+      constexpr int FlightRecorderKey = CollectiveKey + 1;
+
+      enum Statistics {
+        NoStatistics = 0,
+        CountEvaluations,
+        MeasureCycles
+      };
+
+      inline bool isKeyEnabled(int key) {
+        if (key==SamplingKey) {
+          return dilbert_AssertSample>1;
+        }
+        if (key==StatisticsKey) {
+          return dilbert_AssertStatistics!=NoStatistics;
+        }
+        if (key==CollectiveKey) {
+          return dilbert_AssertCollectives;
+        }
+        if (key==FlightRecorderKey) {
+          return dilbert_FlightRecorder!=NULL;
+        }
+        return (dilbert_AssertScopes & (1u << (key / NumberOfCosts))) && key % NumberOfCosts <= dilbert_AssertCost;
+      }
+
+      /**
+       * One entry of the dilbert_static_branches section. The key identifies
+       * the switch the branch belongs to, i.e. the scope and cost of the
+       * assertion.
+       */
+      struct StaticBranch {
+        unsigned long code;
+        unsigned long target;
+        unsigned long key;
+      };
+
+      #ifdef DILBERT_STATIC_BRANCHES
+      template <int Key>
+      __attribute__((always_inline)) inline bool staticBranch() {
+        asm goto (
+          "1: .byte 0x0f, 0x1f, 0x44, 0x00, 0x00\n\t"
+          ".pushsection dilbert_static_branches, \"aw?\"\n\t"
+          ".balign 8\n\t"
+          ".quad 1b, %l[enabled], %c0\n\t"
+          ".popsection\n\t"
+          : : "i" (Key) : : enabled );
+        return false;
+      enabled:
+        return true;
+      }
+      #else
+      template <int Key>
+      inline bool staticBranch() {
+        return isKeyEnabled(Key);
+      }
+      #endif
+
+      /**
+       * Counts down the evaluations of one assertion site on one thread and
+       * returns true for every dilbert_AssertSample-th evaluation.
+       */
+      inline bool sample(unsigned int& countdown) {
+        if (countdown>0) {
+          countdown--;
+          return false;
+        }
+        countdown = dilbert_AssertSample-1;
+        return true;
+      }
+
+      /**
+       * Rewrites all static branches according to dilbert_AssertScopes,
+       * dilbert_AssertCost, dilbert_AssertSample and
+       * dilbert_AssertStatistics. Has to be called whenever one of them
+       * changes, and only while no other thread executes code with
+       * assertions. Returns false if the code could not be patched.
+       */
+      bool updateStaticBranches();
+
+      /**
+       * Every assertion site owns one Site object. It is a constant
+       * initialised static, i.e. it costs nothing before the site registers
+       * itself in the statistics on its first evaluation.
+       *
+       * The demotion is set by the budget governor: A site with demotion d
+       * is checked only every 2^d-th time, and MaxDemotion switches it off.
+       */
+      struct Site {
+        const char*      file;
+        int              line;
+        const char*      condition;
+        std::atomic<int> id;
+        std::atomic<int> demotion;
+      };
+
+      const int MaxDemotion = 10;
+
+      /**
+       * Bracket the evaluation of an assertion's condition if statistics are
+       * switched on. Both calls may nest, as a condition can call code that
+       * again contains assertions. If startEvaluation() returns false, the
+       * governor has demoted the site and the condition must not be
+       * evaluated (and stopEvaluation() not be called).
+       */
+      bool startEvaluation(Site& site);
+      bool stopEvaluation(bool failed);
+
+      /**
+       * Translates "counts" or "cycles" into a Statistics value.
+       */
+      int parseStatistics(const char* statistics);
+
+      /**
+       * Plots the most expensive sites and writes all of them into the CSV
+       * file if one is given (NULL otherwise).
+       */
+      void reportStatistics(int rank, const char* csvFile);
+
+      /**
+       * Kernel variants: A hot kernel can be written as template over a bool
+       * Checked and then be compiled twice. Within the kernel, the macro
+       * DILBERT_ASSERTION_VARIANT(Checked) makes all assertions depend on the
+       * template argument. The unchecked variant thus contains no assertion
+       * code at all and the compiler is free to vectorise its loops.
+       *
+       * \code
+       * template <bool Checked>
+       * void scale(double* data, int n, double factor) {
+       *   DILBERT_ASSERTION_VARIANT(Checked);
+       *   for (int i=0; i<n; i++) {
+       *     assertion2( data[i]==data[i], i, data[i] );
+       *     data[i] *= factor;
+       *   }
+       * }
+       *
+       * dilbert::assertions::KernelVariants<void(double*,int,double)> scaleKernel( scale<true>, scale<false> );
+       *
+       * scaleKernel(data, n, 2.0);
+       * \endcode
+       *
+       * All KernelVariants objects are collected in a list, and
+       * peano::initParallelEnvironment() selects the variant once the MODE is
+       * known. A call then is a plain call through a function pointer.
+       * Objects with automatic storage are fine, they leave the list again
+       * when they are destroyed.
+       */
+      class KernelVariantsBase {
+        private:
+          static KernelVariantsBase* _first;
+          KernelVariantsBase*        _next;
+
+          friend void selectKernelVariants();
+        protected:
+          KernelVariantsBase();
+          virtual ~KernelVariantsBase();
+          virtual void select(bool checked) = 0;
+      };
+
+      template <typename Function>
+      class KernelVariants: public KernelVariantsBase {
+        private:
+          Function* const _checked;
+          Function* const _unchecked;
+          Function*       _active;
+        protected:
+          void select(bool checked) {
+            _active = checked ? _checked : _unchecked;
+          }
+        public:
+          KernelVariants(Function* checked, Function* unchecked):
+            _checked(checked),
+            _unchecked(unchecked),
+            _active(dilbert_Asserts ? checked : unchecked) {
+          }
+
+          /**
+           * Allows to call the object like the kernel itself.
+           */
+          operator Function*() const {
+            return _active;
+          }
+      };
+
+      /**
+       * Selects the checked or unchecked variant of all kernels according to
+       * dilbert_Asserts.
+       */
+      void selectKernelVariants();
+
+      /**
+       * Kernels of the bulk assertions such as assertionAllFinite(). They
+       * return the first index i<n which violates the check, or -1. Each is
+       * vectorised for AVX2 and AVX-512, and the best variant the CPU
+       * supports is selected once at startup. NaN violates every check.
+       */
+      int findNonFinite(const double* data, int n);
+      int findOutOfRange(const double* data, int n, double lower, double upper);
+      int findNumericalDifference(const double* lhs, const double* rhs, int n, double tolerance);
+
+      /**
+       * "avx512", "avx2" or "scalar".
+       */
+      const char* getBulkKernelName();
+
+      /**
+       * Parses DILBERT_ASSERT_TOLERANCE into the three tolerances. Returns
+       * false (and changes nothing) for a malformed list.
+       */
+      bool parseNumericalTolerance(const char* tolerance, double& absolute, double& relative, long long& ulps);
+
+      /**
+       * Sets the tolerances of the numerical comparisons at runtime. A
+       * value of 0 switches the respective criterion off. Not thread-safe,
+       * i.e. to be called between two traversals.
+       */
+      void setNumericalTolerance(double absolute, double relative, long long ulps);
+
+      /**
+       * Distance of two doubles in units in the last place, i.e. the number
+       * of representable doubles in-between plus one. -0 and +0 coincide.
+       */
+      inline unsigned long long getUlpDistance(double lhs, double rhs) {
+        long long lhsBits, rhsBits;
+        std::memcpy(&lhsBits, &lhs, sizeof(double));
+        std::memcpy(&rhsBits, &rhs, sizeof(double));
+        // map the sign-magnitude patterns onto ordered integers, branch-free
+        const long long lhsSign    = lhsBits >> 63;
+        const long long rhsSign    = rhsBits >> 63;
+        const long long lhsOrdered = ((lhsBits & std::numeric_limits<long long>::max()) ^ lhsSign) - lhsSign;
+        const long long rhsOrdered = ((rhsBits & std::numeric_limits<long long>::max()) ^ rhsSign) - rhsSign;
+        const unsigned long long difference = static_cast<unsigned long long>(lhsOrdered) - static_cast<unsigned long long>(rhsOrdered);
+        const unsigned long long negative   = -static_cast<unsigned long long>(lhsOrdered<rhsOrdered);
+        return (difference ^ negative) - negative;
+      }
+
+      /**
+       * Comparison of the numerical assertions. It has no branches (note the
+       * bitwise operators), so loops over it vectorise. NaN never is equal.
+       */
+      inline bool isNumericallyEqual(double lhs, double rhs, double absolute, double relative, long long ulps) {
+        const double difference = std::abs(lhs-rhs);
+        const double magnitude  = std::abs(lhs)>std::abs(rhs) ? std::abs(lhs) : std::abs(rhs);
+        return (difference <= absolute + relative*magnitude)
+             | ((ulps>0) & (lhs==lhs) & (rhs==rhs) & (getUlpDistance(lhs,rhs) <= static_cast<unsigned long long>(ulps)));
+      }
+
+      /**
+       * Result of the numerical comparisons: The first component (counted
+       * row-wise for matrices) which differs and its two values, or index -1
+       * if all are equal.
+       */
+      struct NumericalDifference {
+        int    index;
+        int    components;
+        double lhs;
+        double rhs;
+      };
+
+      /**
+       * Failure path of findNumericalDifference(): Searches the first of the
+       * n components which differs.
+       */
+      DILBERT_COLD NumericalDifference locateNumericalDifference(const double* lhs, const double* rhs, int n);
+
+      /**
+       * Compares Size entries in one pass with the tolerances given by
+       * DILBERT_ASSERT_TOLERANCE, and branches only once. The differing
+       * component is searched for on the failure path only.
+       */
+      template <int Size>
+      NumericalDifference findNumericalDifference(const double* lhs, const double* rhs) {
+        const double    absolute = dilbert_AssertAbsoluteTolerance;
+        const double    relative = dilbert_AssertRelativeTolerance;
+        const long long ulps     = dilbert_AssertUlpTolerance;
+        // an integer (rather than bool) reduction vectorises
+        long long unequal = 0;
+        for (int i=0; i<Size; i++) {
+          unequal |= !isNumericallyEqual(lhs[i], rhs[i], absolute, relative, ulps);
+        }
+        return DILBERT_UNLIKELY(unequal!=0) ? locateNumericalDifference(lhs, rhs, Size) : NumericalDifference{-1, Size, 0.0, 0.0};
+      }
+
+      inline NumericalDifference findNumericalDifference(double lhs, double rhs) {
+        return findNumericalDifference<1>(&lhs, &rhs);
+      }
+
+      /**
+       * Compares the components lhs(0), ..., lhs(Size-1) of anything with an
+       * operator(), as the vector assertions do for Size=DIMENSIONS. The
+       * components are copied into plain arrays first, which the compiler
+       * does in registers.
+       */
+      template <int Size, typename LHS, typename RHS>
+      NumericalDifference findComponentDifference(const LHS& lhs, const RHS& rhs) {
+        double lhsEntries[Size];
+        double rhsEntries[Size];
+        for (int i=0; i<Size; i++) {
+          lhsEntries[i] = lhs(i);
+          rhsEntries[i] = rhs(i);
+        }
+        return findNumericalDifference<Size>(lhsEntries, rhsEntries);
+      }
+
+      /**
+       * Overload for tarch::la::Vector (or any other class template over
+       * the size and scalar type with an operator()).
+       */
+      template <template <int,typename> class Vector, int Size, typename LHSScalar, typename RHSScalar>
+      NumericalDifference findNumericalDifference(const Vector<Size,LHSScalar>& lhs, const Vector<Size,RHSScalar>& rhs) {
+        return findComponentDifference<Size>(lhs, rhs);
+      }
+
+      /**
+       * Overload for tarch::la::Matrix. Entries are counted row-wise.
+       */
+      template <template <int,int,typename> class Matrix, int Rows, int Columns, typename LHSScalar, typename RHSScalar>
+      NumericalDifference findNumericalDifference(const Matrix<Rows,Columns,LHSScalar>& lhs, const Matrix<Rows,Columns,RHSScalar>& rhs) {
+        double lhsEntries[Rows*Columns];
+        double rhsEntries[Rows*Columns];
+        for (int row=0; row<Rows; row++) {
+          for (int column=0; column<Columns; column++) {
+            lhsEntries[row*Columns+column] = lhs(row,column);
+            rhsEntries[row*Columns+column] = rhs(row,column);
+          }
+        }
+        return findNumericalDifference<Rows*Columns>(lhsEntries, rhsEntries);
+      }
+
+      /**
+       * Runtime switches for long runs: With DILBERT_ASSERT_SIGNALS=1, SIGUSR1
+       * switches the given scopes on and SIGUSR2 switches all assertions
+       * off. With DILBERT_ASSERT_CONTROL=file, the file is watched and its
+       * content (a scope list as for DILBERT_ASSERT_SCOPES) is applied
+       * whenever it changes.
+       *
+       * Neither the signal handler nor the file watch touch the assertion
+       * state directly. Both are applied at the next traversal boundary,
+       * i.e. Peano's traversal loop has to call onTraversalBoundary()
+       * between two grid traversals while no other thread runs assertions.
+       * The checks themselves thus need no atomic loads.
+       */
+      void installRuntimeSwitches(unsigned int scopes, bool signals, const char* controlFile);
+
+      /**
+       * Phase window for DILBERT_ASSERT_WINDOW=first:end: The given scopes
+       * are checked in the traversals first, ..., end-1 only, where the
+       * traversals are counted by onTraversalBoundary(). A negative end
+       * leaves the window open. Has to be called before
+       * updateStaticBranches(), as it already sets up the state for
+       * traversal 0.
+       */
+      void installWindow(unsigned int scopes, int first, int end);
+
+      /**
+       * Parses "first:end", "first:" or ":end". Returns false if the string
+       * is malformed.
+       */
+      bool parseWindow(const char* window, int& first, int& end);
+
+      /**
+       * Rank sampling for DILBERT_ASSERT_RANKS: "every:k" selects every k-th
+       * rank, "random:p" or "random:p:seed" a random fraction p of the
+       * ranks and anything else is read as a list such as "0,4,8-15".
+       * Returns false if the string is malformed.
+       */
+      bool parseRanks(const char* ranks, int rank, int numberOfRanks, bool& selected);
+
+      /**
+       * Switches all assertions of a rank off which has not been selected.
+       * Such a rank stays unchecked, i.e. neither the window nor the runtime
+       * switches switch it on again.
+       */
+      void selectRank(bool selected);
+
+      /**
+       * Collective assertions do not communicate. They record their value,
+       * and onTraversalBoundary() checks all pending records in one
+       * MPI_Allreduce (per 32 records) over MPI_COMM_WORLD. Therefore all
+       * ranks have to pass the same collective assertions in the same order,
+       * and only outside of multithreaded regions, just as with any other MPI
+       * collective. Without MPI, all ranks trivially agree.
+       */
+      void recordCollective(Site& site, double value);
+
+      void onTraversalBoundary();
+
+      /**
+       * Events of the flight recorder. The numbers are part of the file
+       * format, i.e. decode-flight-recorder.py has to know them, too.
+       */
+      enum FlightEvent {
+        TraversalBoundary = 0, // payload: number of the traversal
+        EnterCell,             // payload: cell index, e.g. along the curve
+        LeaveCell,
+        Refine,
+        Coarsen,
+        Exchange,              // payload: rank of the neighbour
+        UserEvent,
+        AssertionFailure       // payload: line of the assertion
+      };
+
+      struct FlightRecord {
+        unsigned long long time;
+        unsigned int       event;
+        unsigned int       level;
+        unsigned long long payload;
+      };
+
+      /**
+       * The events of one thread. Only the owning thread writes, and the
+       * ring is read only by a failing thread, i.e. no synchronisation is
+       * needed (the dump is best effort for the other threads).
+       */
+      struct FlightRing {
+        static const int   Size = 4096;
+        FlightRecord       records[Size];
+        unsigned long long written;
+      };
+
+      /**
+       * The thread's ring is a constant initialised thread_local static
+       * member of a class template, which can be defined in this header and
+       * is accessed without any TLS wrapper call.
+       */
+      template <int>
+      struct FlightRecorder {
+        static thread_local FlightRing* ring;
+      };
+
+      template <int N>
+      thread_local FlightRing* FlightRecorder<N>::ring = NULL;
+
+      FlightRing* registerFlightRing();
+
+      inline unsigned long long readFlightClock() {
+        #if defined(__x86_64__) || defined(__i386__)
+        return __builtin_ia32_rdtsc();
+        #else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        #endif
+      }
+
+      /**
+       * Hook for Peano's traversal (via DILBERT_RECORD_EVENT), costs a
+       * timestamp and a store of 24 bytes.
+       */
+      inline void recordFlightEvent(unsigned int event, unsigned int level, unsigned long long payload) {
+        FlightRing* ring = FlightRecorder<0>::ring;
+        if (DILBERT_UNLIKELY(ring==NULL)) {
+          ring = registerFlightRing();
+        }
+        FlightRecord& record = ring->records[ring->written % FlightRing::Size];
+        record.time    = readFlightClock();
+        record.event   = event;
+        record.level   = level;
+        record.payload = payload;
+        ring->written++;
+      }
+
+      /**
+       * Measures the clock frequency for the decoder and registers the
+       * calling thread.
+       */
+      void installFlightRecorder();
+
+      /**
+       * Translates "invalid,divbyzero,overflow,underflow,inexact" (or all)
+       * into a mask of FE_* flags. Returns -1 for unknown names.
+       */
+      int parseFloatingPointTraps(const char* traps);
+
+      /**
+       * Enables dilbert_FloatingPointTraps on the calling thread and installs
+       * the SIGFPE handler. Threads created later inherit the traps. The
+       * workers of OpenMP and TBB, which may exist already or are pooled,
+       * are set up explicitly (the latter by a task_scheduler_observer).
+       */
+      void enableFloatingPointTraps();
+
+      /**
+       * Remembers rank and host, which failure messages, flight recorder and
+       * checkpoint files then use. The SIGFPE handler must not ask MPI for
+       * them. peano::initParallelEnvironment() records them once MPI is
+       * initialised, peano::shutdownParallelEnvironment() forgets them
+       * before MPI is finalised. Both do nothing in serial runs.
+       */
+      void recordOrigin();
+      void forgetOrigin();
+
+      /**
+       * Longest prefix of the flight recorder and checkpoint files, such that
+       * <prefix>-rank<r>.bin fits into the fixed buffers of the failure path.
+       * peano::initParallelEnvironment() rejects longer DILBERT_FLIGHT_RECORDER
+       * values.
+       */
+      constexpr int MaxFilePrefixLength = 472;
+
+      /**
+       * Writes all rings and a backtrace of the calling thread to the flight
+       * recorder file of this rank. Called by the failure path.
+       */
+      void dumpFlightRecorder(const char* file, int line);
+
+      /**
+       * Checkpoint hooks are called once before a failing assertion exits
+       * (i.e. never in MODE=Collect) and from the SIGABRT and SIGTERM
+       * handlers, the latter being how mpirun stops the other ranks after
+       * an MPI_Abort. A hook gets the rank, the reason (such as "assertion
+       * in file f, line l") and its data pointer. As it may run within a
+       * signal handler, it should stick to async-signal-safe calls such as
+       * writeCheckpoint().
+       */
+      typedef void (*CheckpointHook)(int rank, const char* reason, void* data);
+
+      const int MaxCheckpointHooks = 8;
+
+      /**
+       * Returns false if there are MaxCheckpointHooks hooks already.
+       */
+      bool addCheckpointHook(CheckpointHook hook, void* data);
+
+      /**
+       * Calls all hooks, but only on the first call. Is called by the
+       * failure path and the signal handlers.
+       */
+      void runCheckpointHooks(const char* reason);
+      void runCheckpointHooks(const char* file, int line);
+
+      /**
+       * Writes the buffers to <prefix>-rank<r>.chk with writev(2) and no
+       * allocation, i.e. it can be used from a checkpoint hook. The data goes
+       * into a temporary file first, which then replaces the previous
+       * checkpoint, so a crash while writing keeps the last good state.
+       * Returns false on errors.
+       */
+      bool writeCheckpoint(const char* prefix, int rank, const struct iovec* buffers, int count);
+    }
+  }
+
+  namespace peano {
+    /**
+     * Registers a hook which writes a checkpoint before a failing assertion
+     * (or an abort) ends the run, see dilbert::assertions::CheckpointHook.
+     * Part of the init API next to peano::initParallelEnvironment(), and
+     * stored in peano/peano.cpp.
+     */
+    void addCheckpointHook(dilbert::assertions::CheckpointHook hook, void* data);
+  }
+
+  /**
+   * Records an event in the calling thread's flight recorder, e.g.
+   *
+   * \code
+   * DILBERT_RECORD_EVENT(::dilbert::assertions::EnterCell, level, cellIndex);
+   * \endcode
+   *
+   * A switched off recorder costs a NOP.
+   */
+  #define DILBERT_RECORD_EVENT(event,level,payload) \
+    if (DILBERT_UNLIKELY(::dilbert::assertions::staticBranch< ::dilbert::assertions::FlightRecorderKey >())) { \
+      ::dilbert::assertions::recordFlightEvent(event, level, payload); \
+    }
+
+  /**
+   * Is shadowed by DILBERT_ASSERTION_VARIANT within kernel variants. Outside
+   * of those, assertions are always compiled in.
+   */
+  const bool dilbert_CheckedVariant = true;
+
+  #define DILBERT_ASSERTION_VARIANT(Checked) \
+    const bool dilbert_CheckedVariant = (Checked); \
+    (void)dilbert_CheckedVariant
+
+  /**
+   * Is shadowed by DILBERT_ASSERTION_COST.
+   */
+  constexpr int dilbert_AssertionCost = ::dilbert::assertions::Normal;
+
+  #define DILBERT_ASSERTION_COST(cost) \
+    constexpr int dilbert_AssertionCost = (cost); \
+    (void)dilbert_AssertionCost
+
+  #ifndef DILBERT_ASSERTION_SCOPE
+  #define DILBERT_ASSERTION_SCOPE ::dilbert::assertions::getScope(__FILE__)
+  #endif
+
+  /**
+   * Each site has its own countdown per thread, i.e. there is no shared
+   * state between the threads.
+   */
+  #define DILBERT_ASSERTION_SAMPLE() \
+    ( !::dilbert::assertions::staticBranch< ::dilbert::assertions::SamplingKey >() || \
+      []() -> bool { static thread_local unsigned int countdown = 0; return ::dilbert::assertions::sample(countdown); }() )
+
+  #define DILBERT_ASSERTION_SITE(condition) \
+    ( []() -> ::dilbert::assertions::Site& { static ::dilbert::assertions::Site site = { __FILE__, __LINE__, condition, {-1}, {0} }; return site; }() )
+
+  #define DILBERT_ASSERTION_EVALUATE(cond) \
+    ( ::dilbert::assertions::staticBranch< ::dilbert::assertions::StatisticsKey >() \
+      ? ( ::dilbert::assertions::startEvaluation(DILBERT_ASSERTION_SITE(#cond)) && ::dilbert::assertions::stopEvaluation(cond) ) \
+      : (cond) )
+
+  /**
+   * Release builds with -DDILBERT_ASSUME_ASSERTIONS turn the cheap and normal
+   * assertions of unchecked kernel variants into assumptions: The optimiser
+   * may then rely on n%4==0, 0<=i<n and the like to drop remainder loops,
+   * bounds checks and sign fix-ups. Expensive and paranoid conditions are
+   * not turned into assumptions, and neither are conditions with side
+   * effects (see DILBERT_ASSUME), i.e. the unchecked variant never evaluates
+   * an assertion.
+   *
+   * The unchecked variant runs only with assertions switched off. A violated
+   * assumption thus is undefined behaviour that is not reported. Rerun with
+   * MODE=Asserts if in doubt.
+   */
+  #ifdef DILBERT_ASSUME_ASSERTIONS
+  #define DILBERT_ASSERTION_UNCHECKED(cost,cond) ( (cost)<=::dilbert::assertions::Normal ? DILBERT_ASSUME(!(cond)) : (void)0, false )
+  #else
+  #define DILBERT_ASSERTION_UNCHECKED(cost,cond) false
+  #endif
+
+  #define DILBERT_PEANO_IF_ASSERTION_AT(cost,cond) if (!dilbert_CheckedVariant ? DILBERT_ASSERTION_UNCHECKED(cost,cond) : (DILBERT_UNLIKELY(::dilbert::assertions::staticBranch< ::dilbert::assertions::getKey(DILBERT_ASSERTION_SCOPE, cost) >()) && DILBERT_ASSERTION_SAMPLE() && DILBERT_UNLIKELY(DILBERT_ASSERTION_EVALUATE(cond))))
+  #define DILBERT_PEANO_IF_ASSERTION(cond) DILBERT_PEANO_IF_ASSERTION_AT(dilbert_AssertionCost, cond)
 
   /**
    * Define the assert macro. An assertion is given a boolean expression. If
@@ -57,12 +971,326 @@
 
   /* #ifdef Asserts */ // <- nope, we do compile this now always.
     #include "tarch/logging/Log.h"
+    #ifdef Parallel
+    #define assertionTriggersExit { \
+      std::cout.flush(); \
+      std::cerr.flush(); \
+      ::dilbert::assertions::abortAllRanks(); \
+    }
+    #else
     #define assertionTriggersExit { \
       std::cout.flush(); \
       std::cerr.flush(); \
       assert(false); \
       exit(ASSERTION_EXIT_CODE); \
     }
+    #endif
+
+    #include <iostream>
+    #include <string>
+    #include <type_traits>
+
+    namespace dilbert {
+      namespace assertions {
+        /**
+         * Fixed-size output buffer of the failure path. It formats strings,
+         * integers and floating point numbers (the latter exactly as
+         * scientific with 20 digits, as the assertions always did) itself and
+         * writes straight to file descriptor 2 via write(2). It thus neither
+         * allocates memory nor touches the state of std::cerr, and it may be
+         * used from signal handlers. A full buffer is written out and reused.
+         *
+         * Other types (vectors, enums, user types) are streamed through an
+         * std::ostream over the very same buffer.
+         */
+        class Report {
+          public:
+            static const int Capacity = 4096;
+
+            Report();
+            ~Report();
+
+            Report& operator<<(const char* text);
+            Report& operator<<(const std::string& text);
+            Report& operator<<(char character);
+            Report& operator<<(bool value);
+            Report& operator<<(short value);
+            Report& operator<<(unsigned short value);
+            Report& operator<<(int value);
+            Report& operator<<(unsigned int value);
+            Report& operator<<(long value);
+            Report& operator<<(unsigned long value);
+            Report& operator<<(long long value);
+            Report& operator<<(unsigned long long value);
+            Report& operator<<(float value);
+            Report& operator<<(double value);
+            Report& operator<<(const void* address);
+
+            template <typename T>
+            Report& operator<<(const T& value) {
+              std::ostream& out = stream();
+              out << value;
+              return *this;
+            }
+
+            /**
+             * Stream over the buffer, formatted as scientific with 20 digits.
+             */
+            std::ostream& stream();
+
+            void append(const char* text, int length);
+
+            /**
+             * Writes the buffered text to stderr.
+             */
+            void flush();
+
+          private:
+            class StreamBuffer: public std::streambuf {
+              public:
+                explicit StreamBuffer(Report& report);
+              protected:
+                int_type        overflow(int_type character) override;
+                std::streamsize xsputn(const char* text, std::streamsize length) override;
+              private:
+                Report& _report;
+            };
+
+            char          _buffer[Capacity];
+            int           _length;
+            StreamBuffer  _streamBuffer;
+            std::ostream* _stream;
+            alignas(std::ostream) char _streamStorage[sizeof(std::ostream)];
+        };
+
+        /**
+         * Writes value as %.<digits>e would do (correctly rounded, also for
+         * subnormals) into text, which has to hold digits+8 characters.
+         * At most 30 digits are supported. Returns the length.
+         * Async-signal-safe.
+         */
+        int formatScientific(double value, int digits, char* text);
+
+        /**
+         * Writes "rank r on host h: " in front of a failure message in MPI
+         * runs (as recorded by recordOrigin()) and adds "thread t" (the Linux
+         * thread id as shown by gdb) with SharedMemoryParallelisation. Writes
+         * nothing in serial runs. Async-signal-safe on Linux.
+         */
+        void printOrigin(Report& out);
+
+        /**
+         * First-failure latch: Returns if the calling thread is the first one
+         * to fail (or fails again while reporting). Any other thread parks
+         * forever, as the first one is about to terminate the run. So
+         * concurrent failures neither interleave nor race on the exit.
+         */
+        void latchFirstFailure();
+
+        /**
+         * Stops all ranks via MPI_Abort, after dilbert_AssertAbortGrace
+         * seconds. Before MPI is initialised or after it has been finalised,
+         * this falls back to the serial assert(false) and exit().
+         */
+        [[noreturn]] void abortAllRanks();
+
+        /**
+         * The assertion macros below do not stream anything themselves. They
+         * wrap each argument into one of the following items which hold a
+         * reference to the value and are plotted only once reportFailure()
+         * is entered. Thus, the call site of an assertion shrinks to the
+         * comparison and a (rarely taken) call.
+         */
+        template <typename T>
+        struct Parameter {
+          const char* label;
+          const char* name;
+          const T&    value;
+        };
+
+        template <typename LHS, typename RHS>
+        struct Comparison {
+          const char* lhsName;
+          const LHS&  lhs;
+          const char* separator;
+          const char* rhsName;
+          const RHS&  rhs;
+        };
+
+        /**
+         * Messages are arbitrary stream expressions such as
+         * \code "value " << x \endcode and thus are wrapped into a lambda.
+         */
+        template <typename Streamer>
+        struct Message {
+          const Streamer& streamer;
+        };
+
+        template <typename T>
+        Parameter<T> parameter(const char* label, const char* name, const T& value) {
+          return Parameter<T>{label, name, value};
+        }
+
+        template <typename LHS, typename RHS>
+        Comparison<LHS,RHS> comparison(const char* lhsName, const LHS& lhs, const char* separator, const char* rhsName, const RHS& rhs) {
+          return Comparison<LHS,RHS>{lhsName, lhs, separator, rhsName, rhs};
+        }
+
+        template <typename Streamer>
+        Message<Streamer> message(const Streamer& streamer) {
+          return Message<Streamer>{streamer};
+        }
+
+        template <typename T>
+        void print(Report& out, const Parameter<T>& item) {
+          out << item.label << " " << item.name << ": " << item.value << '\n';
+        }
+
+        template <typename LHS, typename RHS>
+        void print(Report& out, const Comparison<LHS,RHS>& item) {
+          out << item.lhsName << "=" << item.lhs << item.separator << item.rhsName << "=" << item.rhs << '\n';
+        }
+
+        template <typename Streamer>
+        void print(Report& out, const Message<Streamer>& item) {
+          item.streamer(out.stream());
+          out << '\n';
+        }
+
+        /**
+         * Plots the differing component of a numerical comparison with the
+         * absolute and relative difference, the distance in ulps and the
+         * tolerances.
+         */
+        void print(Report& out, const NumericalDifference& item);
+
+        inline void printAll(Report&) {}
+
+        template <typename First, typename... Rest>
+        void printAll(Report& out, const First& first, const Rest&... rest) {
+          print(out, first);
+          printAll(out, rest...);
+        }
+
+        /**
+         * In MODE=Collect, a failure keeps the values of its arithmetic
+         * arguments only. Everything else (vectors, messages) would need
+         * formatting, which is exactly what the collect mode avoids.
+         */
+        struct Violation {
+          static const int MaxValues = 4;
+          double           values[MaxValues];
+          int              numberOfValues;
+        };
+
+        template <typename T>
+        void capture(Violation& violation, const T& value, std::true_type) {
+          if (violation.numberOfValues<Violation::MaxValues) {
+            violation.values[violation.numberOfValues++] = static_cast<double>(value);
+          }
+        }
+
+        template <typename T>
+        void capture(Violation&, const T&, std::false_type) {}
+
+        template <typename T>
+        void capture(Violation& violation, const Parameter<T>& item) {
+          capture(violation, item.value, std::is_arithmetic<T>());
+        }
+
+        template <typename LHS, typename RHS>
+        void capture(Violation& violation, const Comparison<LHS,RHS>& item) {
+          capture(violation, item.lhs, std::is_arithmetic<LHS>());
+          capture(violation, item.rhs, std::is_arithmetic<RHS>());
+        }
+
+        template <typename Streamer>
+        void capture(Violation&, const Message<Streamer>&) {}
+
+        inline void capture(Violation& violation, const NumericalDifference& item) {
+          capture(violation, item.index, std::true_type());
+          capture(violation, item.lhs, std::true_type());
+          capture(violation, item.rhs, std::true_type());
+        }
+
+        inline void captureAll(Violation&) {}
+
+        template <typename First, typename... Rest>
+        void captureAll(Violation& violation, const First& first, const Rest&... rest) {
+          capture(violation, first);
+          captureAll(violation, rest...);
+        }
+
+        /**
+         * Stores a failure in the calling thread's ring buffer without any
+         * lock. Failures are counted per site, but only the first
+         * dilbert_AssertCollectLimit ones of each site are stored.
+         */
+        void recordViolation(const char* file, int line, const char* expression, const Violation& violation);
+
+        /**
+         * Plots all sites which failed in MODE=Collect together with the
+         * stored occurrences.
+         */
+        void reportViolations(int rank);
+
+        /**
+         * The one and only failure path of all assertion macros. It is a
+         * template only because of the arbitrary types of the plotted
+         * arguments. std::cout is flushed first (as std::cerr would do) to
+         * keep the order of the output.
+         */
+        template <typename... Items>
+        DILBERT_COLD void reportFailure(const char* file, int line, const char* expression, const Items&... items) {
+          if (dilbert_AssertCollect) {
+            Violation violation = {{0.0}, 0};
+            captureAll(violation, items...);
+            recordViolation(file, line, expression, violation);
+            return;
+          }
+          latchFirstFailure();
+          Report out;
+          printOrigin(out);
+          out << "assertion in file " << file << ", line " << line << " failed: " << expression << '\n';
+          printAll(out, items...);
+          std::cout.flush();
+          out.flush();
+          if (dilbert_FlightRecorder!=NULL) {
+            dumpFlightRecorder(file, line);
+          }
+          runCheckpointHooks(file, line);
+          assertionTriggersExit;
+        }
+
+        template <typename... Items>
+        DILBERT_COLD void reportFail(const char* file, int line, const Items&... items) {
+          if (dilbert_AssertCollect) {
+            Violation violation = {{0.0}, 0};
+            captureAll(violation, items...);
+            recordViolation(file, line, "fail", violation);
+            return;
+          }
+          latchFirstFailure();
+          Report out;
+          printOrigin(out);
+          out << "fail-assertion in file " << file << ", line " << line << '\n';
+          printAll(out, items...);
+          std::cout.flush();
+          out.flush();
+          if (dilbert_FlightRecorder!=NULL) {
+            dumpFlightRecorder(file, line);
+          }
+          runCheckpointHooks(file, line);
+          assertionTriggersExit;
+        }
+      }
+    }
+
+    #define DILBERT_ASSERTION_PARAMETER(label,param) ::dilbert::assertions::parameter(label, #param, param)
+    #define DILBERT_ASSERTION_COMPARISON(lhs,separator,rhs) ::dilbert::assertions::comparison(#lhs, lhs, separator, #rhs, rhs)
+    #define DILBERT_ASSERTION_MESSAGE(msg) ::dilbert::assertions::message([&](std::ostream& out) { out << msg; })
+    #define DILBERT_ASSERTION_DIFFERENCE(lhs,rhs) ::dilbert::assertions::findNumericalDifference((lhs),(rhs))
+    #define DILBERT_ASSERTION_COMPONENT_DIFFERENCE(lhs,rhs) ::dilbert::assertions::findComponentDifference<DIMENSIONS>((lhs),(rhs))
 
     /**
      * @see ASSERTION_EXIT_CODE
@@ -71,9 +1299,7 @@
      * assertion will fail.
      */
     #define assertion(expr) DILBERT_PEANO_IF_ASSERTION (!(expr)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #expr <<  std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #expr); \
     }
 
     /**
@@ -85,19 +1311,15 @@
      * \code operator<< \endcode
      */
     #define assertion1(expr,param) DILBERT_PEANO_IF_ASSERTION (!(expr)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #expr <<  std::endl; \
-      std::cerr << "parameter " << #param << ": " << param << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #expr, \
+        DILBERT_ASSERTION_PARAMETER("parameter",param)); \
     }
 
 
     #define assertion1WithExplanation(expr,param,explanation) DILBERT_PEANO_IF_ASSERTION (!(expr)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #expr <<  std::endl; \
-      std::cerr << "parameter " << #param << ": " << param << std::endl; \
-      std::cerr << explanation << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #expr, \
+        DILBERT_ASSERTION_PARAMETER("parameter",param), \
+        DILBERT_ASSERTION_MESSAGE(explanation)); \
     }
 
 
@@ -110,11 +1332,9 @@
      * \code operator<< \endcode
      */
     #define assertion2(expr,param0,param1) DILBERT_PEANO_IF_ASSERTION (!(expr)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #expr <<  std::endl; \
-      std::cerr << "parameter " << #param0 << ": " << param0 << std::endl; \
-      std::cerr << "parameter " << #param1 << ": " << param1 << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #expr, \
+        DILBERT_ASSERTION_PARAMETER("parameter",param0), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param1)); \
     }
 
     /**
@@ -126,12 +1346,10 @@
      * \code operator<< \endcode
      */
     #define assertion3(expr,param0,param1,param2) DILBERT_PEANO_IF_ASSERTION (!(expr)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #expr <<  std::endl; \
-      std::cerr << "parameter " << #param0 << ": " << param0 << std::endl; \
-      std::cerr << "parameter " << #param1 << ": " << param1 << std::endl; \
-      std::cerr << "parameter " << #param2 << ": " << param2 << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #expr, \
+        DILBERT_ASSERTION_PARAMETER("parameter",param0), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param1), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param2)); \
     }
 
     /**
@@ -143,13 +1361,11 @@
      * \code operator<< \endcode
      */
     #define assertion4(expr,param0,param1,param2,param3) DILBERT_PEANO_IF_ASSERTION (!(expr)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #expr <<  std::endl; \
-      std::cerr << "parameter " << #param0 << ": " << param0 << std::endl; \
-      std::cerr << "parameter " << #param1 << ": " << param1 << std::endl; \
-      std::cerr << "parameter " << #param2 << ": " << param2 << std::endl; \
-      std::cerr << "parameter " << #param3 << ": " << param3 << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #expr, \
+        DILBERT_ASSERTION_PARAMETER("parameter",param0), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param1), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param2), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param3)); \
     }
 
     /**
@@ -161,14 +1377,12 @@
      * \code operator<< \endcode
      */
     #define assertion5(expr,param0,param1,param2,param3,param4) DILBERT_PEANO_IF_ASSERTION (!(expr)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #expr <<  std::endl; \
-      std::cerr << "parameter " << #param0 << ": " << param0 << std::endl; \
-      std::cerr << "parameter " << #param1 << ": " << param1 << std::endl; \
-      std::cerr << "parameter " << #param2 << ": " << param2 << std::endl; \
-      std::cerr << "parameter " << #param3 << ": " << param3 << std::endl; \
-      std::cerr << "parameter " << #param4 << ": " << param4 << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #expr, \
+        DILBERT_ASSERTION_PARAMETER("parameter",param0), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param1), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param2), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param3), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param4)); \
     }
 
     /**
@@ -180,15 +1394,13 @@
      * \code operator<< \endcode
      */
     #define assertion6(expr,param0,param1,param2,param3,param4,param5) DILBERT_PEANO_IF_ASSERTION (!(expr)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #expr <<  std::endl; \
-      std::cerr << "parameter " << #param0 << ": " << param0 << std::endl; \
-      std::cerr << "parameter " << #param1 << ": " << param1 << std::endl; \
-      std::cerr << "parameter " << #param2 << ": " << param2 << std::endl; \
-      std::cerr << "parameter " << #param3 << ": " << param3 << std::endl; \
-      std::cerr << "parameter " << #param4 << ": " << param4 << std::endl; \
-      std::cerr << "parameter " << #param5 << ": " << param5 << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #expr, \
+        DILBERT_ASSERTION_PARAMETER("parameter",param0), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param1), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param2), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param3), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param4), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param5)); \
     }
 
     /**
@@ -200,16 +1412,14 @@
      * \code operator<< \endcode
      */
     #define assertion7(expr,param0,param1,param2,param3,param4,param5,param6) DILBERT_PEANO_IF_ASSERTION (!(expr)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #expr <<  std::endl; \
-      std::cerr << "parameter " << #param0 << ": " << param0 << std::endl; \
-      std::cerr << "parameter " << #param1 << ": " << param1 << std::endl; \
-      std::cerr << "parameter " << #param2 << ": " << param2 << std::endl; \
-      std::cerr << "parameter " << #param3 << ": " << param3 << std::endl; \
-      std::cerr << "parameter " << #param4 << ": " << param4 << std::endl; \
-      std::cerr << "parameter " << #param5 << ": " << param5 << std::endl; \
-      std::cerr << "parameter " << #param6 << ": " << param6 << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #expr, \
+        DILBERT_ASSERTION_PARAMETER("parameter",param0), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param1), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param2), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param3), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param4), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param5), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param6)); \
     }
 
     /**
@@ -221,17 +1431,15 @@
      * \code operator<< \endcode
      */
     #define assertion8(expr,param0,param1,param2,param3,param4,param5,param6,param7) DILBERT_PEANO_IF_ASSERTION (!(expr)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #expr <<  std::endl; \
-      std::cerr << "parameter " << #param0 << ": " << param0 << std::endl; \
-      std::cerr << "parameter " << #param1 << ": " << param1 << std::endl; \
-      std::cerr << "parameter " << #param2 << ": " << param2 << std::endl; \
-      std::cerr << "parameter " << #param3 << ": " << param3 << std::endl; \
-      std::cerr << "parameter " << #param4 << ": " << param4 << std::endl; \
-      std::cerr << "parameter " << #param5 << ": " << param5 << std::endl; \
-      std::cerr << "parameter " << #param6 << ": " << param6 << std::endl; \
-      std::cerr << "parameter " << #param7 << ": " << param7 << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #expr, \
+        DILBERT_ASSERTION_PARAMETER("parameter",param0), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param1), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param2), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param3), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param4), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param5), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param6), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param7)); \
     }
 
     /**
@@ -243,104 +1451,94 @@
      * \code operator<< \endcode
      */
     #define assertion9(expr,param0,param1,param2,param3,param4,param5,param6,param7,param8) DILBERT_PEANO_IF_ASSERTION (!(expr)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #expr <<  std::endl; \
-      std::cerr << "parameter " << #param0 << ": " << param0 << std::endl; \
-      std::cerr << "parameter " << #param1 << ": " << param1 << std::endl; \
-      std::cerr << "parameter " << #param2 << ": " << param2 << std::endl; \
-      std::cerr << "parameter " << #param3 << ": " << param3 << std::endl; \
-      std::cerr << "parameter " << #param4 << ": " << param4 << std::endl; \
-      std::cerr << "parameter " << #param5 << ": " << param5 << std::endl; \
-      std::cerr << "parameter " << #param6 << ": " << param6 << std::endl; \
-      std::cerr << "parameter " << #param7 << ": " << param7 << std::endl; \
-      std::cerr << "parameter " << #param8 << ": " << param8 << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #expr, \
+        DILBERT_ASSERTION_PARAMETER("parameter",param0), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param1), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param2), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param3), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param4), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param5), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param6), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param7), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param8)); \
     }
 
 
     #define assertion10(expr,param0,param1,param2,param3,param4,param5,param6,param7,param8,param9) DILBERT_PEANO_IF_ASSERTION (!(expr)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #expr <<  std::endl; \
-      std::cerr << "parameter " << #param0 << ": " << param0 << std::endl; \
-      std::cerr << "parameter " << #param1 << ": " << param1 << std::endl; \
-      std::cerr << "parameter " << #param2 << ": " << param2 << std::endl; \
-      std::cerr << "parameter " << #param3 << ": " << param3 << std::endl; \
-      std::cerr << "parameter " << #param4 << ": " << param4 << std::endl; \
-      std::cerr << "parameter " << #param5 << ": " << param5 << std::endl; \
-      std::cerr << "parameter " << #param6 << ": " << param6 << std::endl; \
-      std::cerr << "parameter " << #param7 << ": " << param7 << std::endl; \
-      std::cerr << "parameter " << #param8 << ": " << param8 << std::endl; \
-      std::cerr << "parameter " << #param9 << ": " << param9 << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #expr, \
+        DILBERT_ASSERTION_PARAMETER("parameter",param0), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param1), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param2), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param3), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param4), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param5), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param6), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param7), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param8), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param9)); \
     }
 
 
     #define assertion11(expr,param0,param1,param2,param3,param4,param5,param6,param7,param8,param9,param10) DILBERT_PEANO_IF_ASSERTION (!(expr)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #expr <<  std::endl; \
-      std::cerr << "parameter " << #param0 << ": " << param0 << std::endl; \
-      std::cerr << "parameter " << #param1 << ": " << param1 << std::endl; \
-      std::cerr << "parameter " << #param2 << ": " << param2 << std::endl; \
-      std::cerr << "parameter " << #param3 << ": " << param3 << std::endl; \
-      std::cerr << "parameter " << #param4 << ": " << param4 << std::endl; \
-      std::cerr << "parameter " << #param5 << ": " << param5 << std::endl; \
-      std::cerr << "parameter " << #param6 << ": " << param6 << std::endl; \
-      std::cerr << "parameter " << #param7 << ": " << param7 << std::endl; \
-      std::cerr << "parameter " << #param8 << ": " << param8 << std::endl; \
-      std::cerr << "parameter " << #param9 << ": " << param9 << std::endl; \
-      std::cerr << "parameter " << #param10 << ": " << param10 << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #expr, \
+        DILBERT_ASSERTION_PARAMETER("parameter",param0), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param1), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param2), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param3), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param4), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param5), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param6), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param7), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param8), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param9), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param10)); \
     }
 
 
     #define assertion12(expr,param0,param1,param2,param3,param4,param5,param6,param7,param8,param9,param10,param11) DILBERT_PEANO_IF_ASSERTION (!(expr)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #expr <<  std::endl; \
-      std::cerr << "parameter " << #param0 << ": " << param0 << std::endl; \
-      std::cerr << "parameter " << #param1 << ": " << param1 << std::endl; \
-      std::cerr << "parameter " << #param2 << ": " << param2 << std::endl; \
-      std::cerr << "parameter " << #param3 << ": " << param3 << std::endl; \
-      std::cerr << "parameter " << #param4 << ": " << param4 << std::endl; \
-      std::cerr << "parameter " << #param5 << ": " << param5 << std::endl; \
-      std::cerr << "parameter " << #param6 << ": " << param6 << std::endl; \
-      std::cerr << "parameter " << #param7 << ": " << param7 << std::endl; \
-      std::cerr << "parameter " << #param8 << ": " << param8 << std::endl; \
-      std::cerr << "parameter " << #param9 << ": " << param9 << std::endl; \
-      std::cerr << "parameter " << #param10 << ": " << param10 << std::endl; \
-      std::cerr << "parameter " << #param11 << ": " << param11 << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #expr, \
+        DILBERT_ASSERTION_PARAMETER("parameter",param0), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param1), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param2), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param3), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param4), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param5), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param6), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param7), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param8), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param9), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param10), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param11)); \
     }
 
 
     #define assertion25(expr,param0,param1,param2,param3,param4,param5,param6,param7,param8,param9,param10,param11,param12,param13,param14,param15,param16,param17,param18,param19,param20,param21,param22,param23,param24) DILBERT_PEANO_IF_ASSERTION (!(expr)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #expr <<  std::endl; \
-      std::cerr << "parameter " << #param0 << ": " << param0 << std::endl; \
-      std::cerr << "parameter " << #param1 << ": " << param1 << std::endl; \
-      std::cerr << "parameter " << #param2 << ": " << param2 << std::endl; \
-      std::cerr << "parameter " << #param3 << ": " << param3 << std::endl; \
-      std::cerr << "parameter " << #param4 << ": " << param4 << std::endl; \
-      std::cerr << "parameter " << #param5 << ": " << param5 << std::endl; \
-      std::cerr << "parameter " << #param6 << ": " << param6 << std::endl; \
-      std::cerr << "parameter " << #param7 << ": " << param7 << std::endl; \
-      std::cerr << "parameter " << #param8 << ": " << param8 << std::endl; \
-      std::cerr << "parameter " << #param9 << ": " << param9 << std::endl; \
-      std::cerr << "parameter " << #param10 << ": " << param10 << std::endl; \
-      std::cerr << "parameter " << #param11 << ": " << param11 << std::endl; \
-      std::cerr << "parameter " << #param12 << ": " << param12 << std::endl; \
-      std::cerr << "parameter " << #param13 << ": " << param13 << std::endl; \
-      std::cerr << "parameter " << #param14 << ": " << param14 << std::endl; \
-      std::cerr << "parameter " << #param15 << ": " << param15 << std::endl; \
-      std::cerr << "parameter " << #param16 << ": " << param16 << std::endl; \
-      std::cerr << "parameter " << #param17 << ": " << param17 << std::endl; \
-      std::cerr << "parameter " << #param18 << ": " << param18 << std::endl; \
-      std::cerr << "parameter " << #param19 << ": " << param19 << std::endl; \
-      std::cerr << "parameter " << #param20 << ": " << param20 << std::endl; \
-      std::cerr << "parameter " << #param21 << ": " << param21 << std::endl; \
-      std::cerr << "parameter " << #param22 << ": " << param22 << std::endl; \
-      std::cerr << "parameter " << #param23 << ": " << param23 << std::endl; \
-      std::cerr << "parameter " << #param24 << ": " << param24 << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #expr, \
+        DILBERT_ASSERTION_PARAMETER("parameter",param0), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param1), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param2), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param3), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param4), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param5), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param6), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param7), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param8), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param9), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param10), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param11), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param12), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param13), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param14), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param15), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param16), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param17), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param18), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param19), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param20), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param21), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param22), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param23), \
+        DILBERT_ASSERTION_PARAMETER("parameter",param24)); \
     }
 
 
@@ -351,9 +1549,8 @@
      * To compare them, the operator \code operator== \endcode is used.
      */
     #define assertionEquals(lhs,rhs) DILBERT_PEANO_IF_ASSERTION ((lhs)!=(rhs)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t" << #rhs << "=" << rhs << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t",rhs)); \
     }
 
     /**
@@ -363,10 +1560,9 @@
      * To compare them, the operator \code operator== \endcode is used.
      */
     #define assertionEqualsMsg(lhs,rhs,msg) DILBERT_PEANO_IF_ASSERTION ((lhs)!=(rhs)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t" << #rhs << "=" << rhs << std::endl; \
-      std::cerr << msg << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t",rhs), \
+        DILBERT_ASSERTION_MESSAGE(msg)); \
     }
 
     /**
@@ -379,10 +1575,9 @@
      * \code operator<< \endcode
      */
     #define assertionEquals1(lhs,rhs,larg) DILBERT_PEANO_IF_ASSERTION ((lhs)!=(rhs)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t" << #rhs << "=" << rhs << std::endl; \
-      std::cerr << "1st argument " << #larg << ": " << larg << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t",rhs), \
+        DILBERT_ASSERTION_PARAMETER("1st argument",larg)); \
     }
 
     /**
@@ -395,11 +1590,10 @@
      * \code operator<< \endcode
      */
     #define assertionEquals2(lhs,rhs,larg,rarg) DILBERT_PEANO_IF_ASSERTION ((lhs)!=(rhs)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t" << #rhs << "=" << rhs << std::endl; \
-      std::cerr << "left argument " << #larg << ": " << larg << std::endl; \
-      std::cerr << "right argument " << #rarg << ": " << rarg << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t",rhs), \
+        DILBERT_ASSERTION_PARAMETER("left argument",larg), \
+        DILBERT_ASSERTION_PARAMETER("right argument",rarg)); \
     }
 
     /**
@@ -412,12 +1606,11 @@
      * \code operator<< \endcode
      */
     #define assertionEquals3(lhs,rhs,larg,rarg,three) DILBERT_PEANO_IF_ASSERTION ((lhs)!=(rhs)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t" << #rhs << "=" << rhs << std::endl; \
-      std::cerr << "1st argument " << #larg << ": " << larg << std::endl; \
-      std::cerr << "2nd argument " << #rarg << ": " << rarg << std::endl; \
-      std::cerr << "3rd argument " << #three << ": " << three << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t",rhs), \
+        DILBERT_ASSERTION_PARAMETER("1st argument",larg), \
+        DILBERT_ASSERTION_PARAMETER("2nd argument",rarg), \
+        DILBERT_ASSERTION_PARAMETER("3rd argument",three)); \
     }
 
     /**
@@ -430,13 +1623,12 @@
      * \code operator<< \endcode
      */
     #define assertionEquals4(lhs,rhs,larg,rarg,three,four) DILBERT_PEANO_IF_ASSERTION ((lhs)!=(rhs)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t" << #rhs << "=" << rhs << std::endl; \
-      std::cerr << "1st argument " << #larg << ": " << larg << std::endl; \
-      std::cerr << "2nd argument " << #rarg << ": " << rarg << std::endl; \
-      std::cerr << "3rd argument " << #three << ": " << three << std::endl; \
-      std::cerr << "4th argument " << #four << ": " << four << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t",rhs), \
+        DILBERT_ASSERTION_PARAMETER("1st argument",larg), \
+        DILBERT_ASSERTION_PARAMETER("2nd argument",rarg), \
+        DILBERT_ASSERTION_PARAMETER("3rd argument",three), \
+        DILBERT_ASSERTION_PARAMETER("4th argument",four)); \
     }
 
     /**
@@ -449,14 +1641,13 @@
      * \code operator<< \endcode
      */
     #define assertionEquals5(lhs,rhs,larg,rarg,three,four,five) DILBERT_PEANO_IF_ASSERTION ((lhs)!=(rhs)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t" << #rhs << "=" << rhs << std::endl; \
-      std::cerr << "1st argument " << #larg << ": " << larg << std::endl; \
-      std::cerr << "2nd argument " << #rarg << ": " << rarg << std::endl; \
-      std::cerr << "3rd argument " << #three << ": " << three << std::endl; \
-      std::cerr << "4th argument " << #four << ": " << four << std::endl; \
-      std::cerr << "5th argument " << #five << ": " << five << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t",rhs), \
+        DILBERT_ASSERTION_PARAMETER("1st argument",larg), \
+        DILBERT_ASSERTION_PARAMETER("2nd argument",rarg), \
+        DILBERT_ASSERTION_PARAMETER("3rd argument",three), \
+        DILBERT_ASSERTION_PARAMETER("4th argument",four), \
+        DILBERT_ASSERTION_PARAMETER("5th argument",five)); \
     }
 
     /**
@@ -469,15 +1660,14 @@
      * \code operator<< \endcode
      */
     #define assertionEquals6(lhs,rhs,larg,rarg,three,four,five,six) DILBERT_PEANO_IF_ASSERTION ((lhs)!=(rhs)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t" << #rhs << "=" << rhs << std::endl; \
-      std::cerr << "1st argument " << #larg << ": " << larg << std::endl; \
-      std::cerr << "2nd argument " << #rarg << ": " << rarg << std::endl; \
-      std::cerr << "3rd argument " << #three << ": " << three << std::endl; \
-      std::cerr << "4th argument " << #four << ": " << four << std::endl; \
-      std::cerr << "5th argument " << #five << ": " << five << std::endl; \
-      std::cerr << "6th argument " << #six << ": " << six << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t",rhs), \
+        DILBERT_ASSERTION_PARAMETER("1st argument",larg), \
+        DILBERT_ASSERTION_PARAMETER("2nd argument",rarg), \
+        DILBERT_ASSERTION_PARAMETER("3rd argument",three), \
+        DILBERT_ASSERTION_PARAMETER("4th argument",four), \
+        DILBERT_ASSERTION_PARAMETER("5th argument",five), \
+        DILBERT_ASSERTION_PARAMETER("6th argument",six)); \
     }
 
     /**
@@ -490,16 +1680,15 @@
      * \code operator<< \endcode
      */
     #define assertionEquals7(lhs,rhs,larg,rarg,three,four,five,six,seven) DILBERT_PEANO_IF_ASSERTION ((lhs)!=(rhs)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t" << #rhs << "=" << rhs << std::endl; \
-      std::cerr << "1st argument " << #larg << ": " << larg << std::endl; \
-      std::cerr << "2nd argument " << #rarg << ": " << rarg << std::endl; \
-      std::cerr << "3rd argument " << #three << ": " << three << std::endl; \
-      std::cerr << "4th argument " << #four << ": " << four << std::endl; \
-      std::cerr << "5th argument " << #five << ": " << five << std::endl; \
-      std::cerr << "6th argument " << #six << ": " << six << std::endl; \
-      std::cerr << "7th argument " << #seven << ": " << seven << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t",rhs), \
+        DILBERT_ASSERTION_PARAMETER("1st argument",larg), \
+        DILBERT_ASSERTION_PARAMETER("2nd argument",rarg), \
+        DILBERT_ASSERTION_PARAMETER("3rd argument",three), \
+        DILBERT_ASSERTION_PARAMETER("4th argument",four), \
+        DILBERT_ASSERTION_PARAMETER("5th argument",five), \
+        DILBERT_ASSERTION_PARAMETER("6th argument",six), \
+        DILBERT_ASSERTION_PARAMETER("7th argument",seven)); \
     }
 
     /**
@@ -512,455 +1701,589 @@
      * \code operator<< \endcode
      */
     #define assertionEquals8(lhs,rhs,larg,rarg,three,four,five,six,seven,eight) DILBERT_PEANO_IF_ASSERTION ((lhs)!=(rhs)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t" << #rhs << "=" << rhs << std::endl; \
-      std::cerr << "1st argument " << #larg << ": " << larg << std::endl; \
-      std::cerr << "2nd argument " << #rarg << ": " << rarg << std::endl; \
-      std::cerr << "3rd argument " << #three << ": " << three << std::endl; \
-      std::cerr << "4th argument " << #four << ": " << four << std::endl; \
-      std::cerr << "5th argument " << #five << ": " << five << std::endl; \
-      std::cerr << "6th argument " << #six << ": " << six << std::endl; \
-      std::cerr << "7th argument " << #seven << ": " << seven << std::endl; \
-      std::cerr << "8th argument " << #eight << ": " << eight << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t",rhs), \
+        DILBERT_ASSERTION_PARAMETER("1st argument",larg), \
+        DILBERT_ASSERTION_PARAMETER("2nd argument",rarg), \
+        DILBERT_ASSERTION_PARAMETER("3rd argument",three), \
+        DILBERT_ASSERTION_PARAMETER("4th argument",four), \
+        DILBERT_ASSERTION_PARAMETER("5th argument",five), \
+        DILBERT_ASSERTION_PARAMETER("6th argument",six), \
+        DILBERT_ASSERTION_PARAMETER("7th argument",seven), \
+        DILBERT_ASSERTION_PARAMETER("8th argument",eight)); \
     }
 
     #define assertionEquals9(lhs,rhs,larg,rarg,three,four,five,six,seven,eight,nine) DILBERT_PEANO_IF_ASSERTION ((lhs)!=(rhs)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t" << #rhs << "=" << rhs << std::endl; \
-      std::cerr << "1st argument " << #larg << ": " << larg << std::endl; \
-      std::cerr << "2nd argument " << #rarg << ": " << rarg << std::endl; \
-      std::cerr << "3rd argument " << #three << ": " << three << std::endl; \
-      std::cerr << "4th argument " << #four << ": " << four << std::endl; \
-      std::cerr << "5th argument " << #five << ": " << five << std::endl; \
-      std::cerr << "6th argument " << #six << ": " << six << std::endl; \
-      std::cerr << "7th argument " << #seven << ": " << seven << std::endl; \
-      std::cerr << "8th argument " << #eight << ": " << eight << std::endl; \
-      std::cerr << "9th argument " << #nine << ": " << nine << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t",rhs), \
+        DILBERT_ASSERTION_PARAMETER("1st argument",larg), \
+        DILBERT_ASSERTION_PARAMETER("2nd argument",rarg), \
+        DILBERT_ASSERTION_PARAMETER("3rd argument",three), \
+        DILBERT_ASSERTION_PARAMETER("4th argument",four), \
+        DILBERT_ASSERTION_PARAMETER("5th argument",five), \
+        DILBERT_ASSERTION_PARAMETER("6th argument",six), \
+        DILBERT_ASSERTION_PARAMETER("7th argument",seven), \
+        DILBERT_ASSERTION_PARAMETER("8th argument",eight), \
+        DILBERT_ASSERTION_PARAMETER("9th argument",nine)); \
     }
 
 
     #define assertionEquals10(lhs,rhs,larg,rarg,three,four,five,six,seven,eight,nine,ten) DILBERT_PEANO_IF_ASSERTION ((lhs)!=(rhs)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t" << #rhs << "=" << rhs << std::endl; \
-      std::cerr << "1st argument " << #larg << ": " << larg << std::endl; \
-      std::cerr << "2nd argument " << #rarg << ": " << rarg << std::endl; \
-      std::cerr << "3rd argument " << #three << ": " << three << std::endl; \
-      std::cerr << "4th argument " << #four << ": " << four << std::endl; \
-      std::cerr << "5th argument " << #five << ": " << five << std::endl; \
-      std::cerr << "6th argument " << #six << ": " << six << std::endl; \
-      std::cerr << "7th argument " << #seven << ": " << seven << std::endl; \
-      std::cerr << "8th argument " << #eight << ": " << eight << std::endl; \
-      std::cerr << "9th argument " << #nine << ": " << nine << std::endl; \
-      std::cerr << "10th argument " << #ten << ": " << ten << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t",rhs), \
+        DILBERT_ASSERTION_PARAMETER("1st argument",larg), \
+        DILBERT_ASSERTION_PARAMETER("2nd argument",rarg), \
+        DILBERT_ASSERTION_PARAMETER("3rd argument",three), \
+        DILBERT_ASSERTION_PARAMETER("4th argument",four), \
+        DILBERT_ASSERTION_PARAMETER("5th argument",five), \
+        DILBERT_ASSERTION_PARAMETER("6th argument",six), \
+        DILBERT_ASSERTION_PARAMETER("7th argument",seven), \
+        DILBERT_ASSERTION_PARAMETER("8th argument",eight), \
+        DILBERT_ASSERTION_PARAMETER("9th argument",nine), \
+        DILBERT_ASSERTION_PARAMETER("10th argument",ten)); \
     }
 
 
     #define assertionEquals11(lhs,rhs,larg,rarg,three,four,five,six,seven,eight,nine,ten,p11) DILBERT_PEANO_IF_ASSERTION ((lhs)!=(rhs)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t" << #rhs << "=" << rhs << std::endl; \
-      std::cerr << "1st argument " << #larg << ": " << larg << std::endl; \
-      std::cerr << "2nd argument " << #rarg << ": " << rarg << std::endl; \
-      std::cerr << "3rd argument " << #three << ": " << three << std::endl; \
-      std::cerr << "4th argument " << #four << ": " << four << std::endl; \
-      std::cerr << "5th argument " << #five << ": " << five << std::endl; \
-      std::cerr << "6th argument " << #six << ": " << six << std::endl; \
-      std::cerr << "7th argument " << #seven << ": " << seven << std::endl; \
-      std::cerr << "8th argument " << #eight << ": " << eight << std::endl; \
-      std::cerr << "9th argument " << #nine << ": " << nine << std::endl; \
-      std::cerr << "10th argument " << #ten << ": " << ten << std::endl; \
-      std::cerr << "11th argument " << #p11<< ": " << p11 << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t",rhs), \
+        DILBERT_ASSERTION_PARAMETER("1st argument",larg), \
+        DILBERT_ASSERTION_PARAMETER("2nd argument",rarg), \
+        DILBERT_ASSERTION_PARAMETER("3rd argument",three), \
+        DILBERT_ASSERTION_PARAMETER("4th argument",four), \
+        DILBERT_ASSERTION_PARAMETER("5th argument",five), \
+        DILBERT_ASSERTION_PARAMETER("6th argument",six), \
+        DILBERT_ASSERTION_PARAMETER("7th argument",seven), \
+        DILBERT_ASSERTION_PARAMETER("8th argument",eight), \
+        DILBERT_ASSERTION_PARAMETER("9th argument",nine), \
+        DILBERT_ASSERTION_PARAMETER("10th argument",ten), \
+        DILBERT_ASSERTION_PARAMETER("11th argument",p11)); \
     }
 
 
     #define assertionEquals12(lhs,rhs,larg,rarg,three,four,five,six,seven,eight,nine,ten,p11,p12) DILBERT_PEANO_IF_ASSERTION ((lhs)!=(rhs)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t" << #rhs << "=" << rhs << std::endl; \
-      std::cerr << "1st argument " << #larg << ": " << larg << std::endl; \
-      std::cerr << "2nd argument " << #rarg << ": " << rarg << std::endl; \
-      std::cerr << "3rd argument " << #three << ": " << three << std::endl; \
-      std::cerr << "4th argument " << #four << ": " << four << std::endl; \
-      std::cerr << "5th argument " << #five << ": " << five << std::endl; \
-      std::cerr << "6th argument " << #six << ": " << six << std::endl; \
-      std::cerr << "7th argument " << #seven << ": " << seven << std::endl; \
-      std::cerr << "8th argument " << #eight << ": " << eight << std::endl; \
-      std::cerr << "9th argument " << #nine << ": " << nine << std::endl; \
-      std::cerr << "10th argument " << #ten << ": " << ten << std::endl; \
-      std::cerr << "11th argument " << #p11<< ": " << p11 << std::endl; \
-      std::cerr << "12th argument " << #p12<< ": " << p12 << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t",rhs), \
+        DILBERT_ASSERTION_PARAMETER("1st argument",larg), \
+        DILBERT_ASSERTION_PARAMETER("2nd argument",rarg), \
+        DILBERT_ASSERTION_PARAMETER("3rd argument",three), \
+        DILBERT_ASSERTION_PARAMETER("4th argument",four), \
+        DILBERT_ASSERTION_PARAMETER("5th argument",five), \
+        DILBERT_ASSERTION_PARAMETER("6th argument",six), \
+        DILBERT_ASSERTION_PARAMETER("7th argument",seven), \
+        DILBERT_ASSERTION_PARAMETER("8th argument",eight), \
+        DILBERT_ASSERTION_PARAMETER("9th argument",nine), \
+        DILBERT_ASSERTION_PARAMETER("10th argument",ten), \
+        DILBERT_ASSERTION_PARAMETER("11th argument",p11), \
+        DILBERT_ASSERTION_PARAMETER("12th argument",p12)); \
     }
 
 
     #define assertionEquals13(lhs,rhs,larg,rarg,three,four,five,six,seven,eight,nine,ten,p11,p12,p13) DILBERT_PEANO_IF_ASSERTION ((lhs)!=(rhs)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t" << #rhs << "=" << rhs << std::endl; \
-      std::cerr << "1st argument " << #larg << ": " << larg << std::endl; \
-      std::cerr << "2nd argument " << #rarg << ": " << rarg << std::endl; \
-      std::cerr << "3rd argument " << #three << ": " << three << std::endl; \
-      std::cerr << "4th argument " << #four << ": " << four << std::endl; \
-      std::cerr << "5th argument " << #five << ": " << five << std::endl; \
-      std::cerr << "6th argument " << #six << ": " << six << std::endl; \
-      std::cerr << "7th argument " << #seven << ": " << seven << std::endl; \
-      std::cerr << "8th argument " << #eight << ": " << eight << std::endl; \
-      std::cerr << "9th argument " << #nine << ": " << nine << std::endl; \
-      std::cerr << "10th argument " << #ten << ": " << ten << std::endl; \
-      std::cerr << "11th argument " << #p11<< ": " << p11 << std::endl; \
-      std::cerr << "12th argument " << #p12<< ": " << p12 << std::endl; \
-      std::cerr << "13th argument " << #p13<< ": " << p13 << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t",rhs), \
+        DILBERT_ASSERTION_PARAMETER("1st argument",larg), \
+        DILBERT_ASSERTION_PARAMETER("2nd argument",rarg), \
+        DILBERT_ASSERTION_PARAMETER("3rd argument",three), \
+        DILBERT_ASSERTION_PARAMETER("4th argument",four), \
+        DILBERT_ASSERTION_PARAMETER("5th argument",five), \
+        DILBERT_ASSERTION_PARAMETER("6th argument",six), \
+        DILBERT_ASSERTION_PARAMETER("7th argument",seven), \
+        DILBERT_ASSERTION_PARAMETER("8th argument",eight), \
+        DILBERT_ASSERTION_PARAMETER("9th argument",nine), \
+        DILBERT_ASSERTION_PARAMETER("10th argument",ten), \
+        DILBERT_ASSERTION_PARAMETER("11th argument",p11), \
+        DILBERT_ASSERTION_PARAMETER("12th argument",p12), \
+        DILBERT_ASSERTION_PARAMETER("13th argument",p13)); \
     }
 
 
     #define assertionEquals14(lhs,rhs,larg,rarg,three,four,five,six,seven,eight,nine,ten,p11,p12,p13,p14) DILBERT_PEANO_IF_ASSERTION ((lhs)!=(rhs)) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t" << #rhs << "=" << rhs << std::endl; \
-      std::cerr << "1st argument " << #larg << ": " << larg << std::endl; \
-      std::cerr << "2nd argument " << #rarg << ": " << rarg << std::endl; \
-      std::cerr << "3rd argument " << #three << ": " << three << std::endl; \
-      std::cerr << "4th argument " << #four << ": " << four << std::endl; \
-      std::cerr << "5th argument " << #five << ": " << five << std::endl; \
-      std::cerr << "6th argument " << #six << ": " << six << std::endl; \
-      std::cerr << "7th argument " << #seven << ": " << seven << std::endl; \
-      std::cerr << "8th argument " << #eight << ": " << eight << std::endl; \
-      std::cerr << "9th argument " << #nine << ": " << nine << std::endl; \
-      std::cerr << "10th argument " << #ten << ": " << ten << std::endl; \
-      std::cerr << "11th argument " << #p11<< ": " << p11 << std::endl; \
-      std::cerr << "12th argument " << #p12<< ": " << p12 << std::endl; \
-      std::cerr << "13th argument " << #p13<< ": " << p13 << std::endl; \
-      std::cerr << "14th argument " << #p14<< ": " << p14 << std::endl; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t",rhs), \
+        DILBERT_ASSERTION_PARAMETER("1st argument",larg), \
+        DILBERT_ASSERTION_PARAMETER("2nd argument",rarg), \
+        DILBERT_ASSERTION_PARAMETER("3rd argument",three), \
+        DILBERT_ASSERTION_PARAMETER("4th argument",four), \
+        DILBERT_ASSERTION_PARAMETER("5th argument",five), \
+        DILBERT_ASSERTION_PARAMETER("6th argument",six), \
+        DILBERT_ASSERTION_PARAMETER("7th argument",seven), \
+        DILBERT_ASSERTION_PARAMETER("8th argument",eight), \
+        DILBERT_ASSERTION_PARAMETER("9th argument",nine), \
+        DILBERT_ASSERTION_PARAMETER("10th argument",ten), \
+        DILBERT_ASSERTION_PARAMETER("11th argument",p11), \
+        DILBERT_ASSERTION_PARAMETER("12th argument",p12), \
+        DILBERT_ASSERTION_PARAMETER("13th argument",p13), \
+        DILBERT_ASSERTION_PARAMETER("14th argument",p14)); \
     }
 
     /**
      * @see ASSERTION_EXIT_CODE
      *
      * Argument lhs and rhs have to be equal besides the machine precision.
-     * Otherwise assertion will fail. The machine precision is evaluated via
-     * equals().
+     * Otherwise assertion will fail. The tolerance is set via
+     * DILBERT_ASSERT_TOLERANCE (see findNumericalDifference()), and lhs and
+     * rhs may also be whole vectors or matrices.
      */
-    #define assertionNumericalEquals(lhs,rhs) DILBERT_PEANO_IF_ASSERTION (!tarch::la::equals( (lhs),(rhs) )) { setAssertionOutputFormat; std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t == \t" << #rhs << "=" << rhs << std::endl; assertionTriggersExit; }
+    #define assertionNumericalEquals(lhs,rhs) DILBERT_PEANO_IF_ASSERTION (::dilbert::assertions::findNumericalDifference((lhs),(rhs)).index>=0) { \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t == \t",rhs), \
+        DILBERT_ASSERTION_DIFFERENCE(lhs,rhs)); \
+    }
 
     /**
      * @see ASSERTION_EXIT_CODE
      *
      * Argument lhs and rhs have to be equal besides the machine precision.
-     * Otherwise assertion will fail. The machine precision is evaluated via
-     * equals().
+     * Otherwise assertion will fail. The tolerance is set via
+     * DILBERT_ASSERT_TOLERANCE (see findNumericalDifference()), and lhs and
+     * rhs may also be whole vectors or matrices.
      *
      * If the assertion fails, the additional parameters
      * are plotted to the command line. The parameters thus have to provide
      * \code operator<< \endcode
      */
-    #define assertionNumericalEquals1(lhs,rhs,a) DILBERT_PEANO_IF_ASSERTION (!tarch::la::equals( (lhs),(rhs) )) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t == \t" << #rhs << "=" << rhs << std::endl; \
-      std::cerr << "argument " << #a << ": " << a << std::endl; \
-      assertionTriggersExit; \
+    #define assertionNumericalEquals1(lhs,rhs,a) DILBERT_PEANO_IF_ASSERTION (::dilbert::assertions::findNumericalDifference((lhs),(rhs)).index>=0) { \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t == \t",rhs), \
+        DILBERT_ASSERTION_DIFFERENCE(lhs,rhs), \
+        DILBERT_ASSERTION_PARAMETER("argument",a)); \
     }
 
     /**
      * @see ASSERTION_EXIT_CODE
      *
      * Argument lhs and rhs have to be equal besides the machine precision.
-     * Otherwise assertion will fail. The machine precision is evaluated via
-     * equals().
+     * Otherwise assertion will fail. The tolerance is set via
+     * DILBERT_ASSERT_TOLERANCE (see findNumericalDifference()), and lhs and
+     * rhs may also be whole vectors or matrices.
      *
      * If the assertion fails, the additional parameters
      * are plotted to the command line. The parameters thus have to provide
      * \code operator<< \endcode
      */
-    #define assertionNumericalEquals2(lhs,rhs,larg,rarg) DILBERT_PEANO_IF_ASSERTION (!tarch::la::equals( (lhs),(rhs) )) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t == \t" << #rhs << "=" << rhs << std::endl; \
-      std::cerr << "left argument " << #larg << ": " << larg << std::endl; \
-      std::cerr << "right argument " << #rarg << ": " << rarg << std::endl; \
-      assertionTriggersExit; \
+    #define assertionNumericalEquals2(lhs,rhs,larg,rarg) DILBERT_PEANO_IF_ASSERTION (::dilbert::assertions::findNumericalDifference((lhs),(rhs)).index>=0) { \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t == \t",rhs), \
+        DILBERT_ASSERTION_DIFFERENCE(lhs,rhs), \
+        DILBERT_ASSERTION_PARAMETER("left argument",larg), \
+        DILBERT_ASSERTION_PARAMETER("right argument",rarg)); \
     }
 
     /**
      * @see ASSERTION_EXIT_CODE
      *
      * Argument lhs and rhs have to be equal besides the machine precision.
-     * Otherwise assertion will fail. The machine precision is evaluated via
-     * equals().
+     * Otherwise assertion will fail. The tolerance is set via
+     * DILBERT_ASSERT_TOLERANCE (see findNumericalDifference()), and lhs and
+     * rhs may also be whole vectors or matrices.
      *
      * If the assertion fails, the additional parameters
      * are plotted to the command line. The parameters thus have to provide
      * \code operator<< \endcode
      */
-    #define assertionNumericalEquals3(lhs,rhs,a,b,c) DILBERT_PEANO_IF_ASSERTION (!tarch::la::equals( (lhs),(rhs) )) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t == \t" << #rhs << "=" << rhs << std::endl; \
-      std::cerr << "first argument " << #a << ": " << a << std::endl; \
-      std::cerr << "second argument " << #b << ": " << b << std::endl; \
-      std::cerr << "third argument " << #c << ": " << c << std::endl; \
-      assertionTriggersExit; \
+    #define assertionNumericalEquals3(lhs,rhs,a,b,c) DILBERT_PEANO_IF_ASSERTION (::dilbert::assertions::findNumericalDifference((lhs),(rhs)).index>=0) { \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t == \t",rhs), \
+        DILBERT_ASSERTION_DIFFERENCE(lhs,rhs), \
+        DILBERT_ASSERTION_PARAMETER("first argument",a), \
+        DILBERT_ASSERTION_PARAMETER("second argument",b), \
+        DILBERT_ASSERTION_PARAMETER("third argument",c)); \
     }
 
     /**
      * @see ASSERTION_EXIT_CODE
      *
      * Argument lhs and rhs have to be equal besides the machine precision.
-     * Otherwise assertion will fail. The machine precision is evaluated via
-     * equals().
+     * Otherwise assertion will fail. The tolerance is set via
+     * DILBERT_ASSERT_TOLERANCE (see findNumericalDifference()), and lhs and
+     * rhs may also be whole vectors or matrices.
      *
      * If the assertion fails, the additional parameters
      * are plotted to the command line. The parameters thus have to provide
      * \code operator<< \endcode
      */
-    #define assertionNumericalEquals4(lhs,rhs,a,b,c,d) DILBERT_PEANO_IF_ASSERTION (!tarch::la::equals( (lhs),(rhs) )) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t == \t" << #rhs << "=" << rhs << std::endl; \
-      std::cerr << "1st argument " << #a << ": " << a << std::endl; \
-      std::cerr << "2nd argument " << #b << ": " << b << std::endl; \
-      std::cerr << "3rd argument " << #c << ": " << c << std::endl; \
-      std::cerr << "4th argument " << #d << ": " << d << std::endl; \
-      assertionTriggersExit; \
+    #define assertionNumericalEquals4(lhs,rhs,a,b,c,d) DILBERT_PEANO_IF_ASSERTION (::dilbert::assertions::findNumericalDifference((lhs),(rhs)).index>=0) { \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t == \t",rhs), \
+        DILBERT_ASSERTION_DIFFERENCE(lhs,rhs), \
+        DILBERT_ASSERTION_PARAMETER("1st argument",a), \
+        DILBERT_ASSERTION_PARAMETER("2nd argument",b), \
+        DILBERT_ASSERTION_PARAMETER("3rd argument",c), \
+        DILBERT_ASSERTION_PARAMETER("4th argument",d)); \
     }
 
     /**
      * @see ASSERTION_EXIT_CODE
      *
      * Argument lhs and rhs have to be equal besides the machine precision.
-     * Otherwise assertion will fail. The machine precision is evaluated via
-     * equals().
+     * Otherwise assertion will fail. The tolerance is set via
+     * DILBERT_ASSERT_TOLERANCE (see findNumericalDifference()), and lhs and
+     * rhs may also be whole vectors or matrices.
      *
      * If the assertion fails, the additional parameters
      * are plotted to the command line. The parameters thus have to provide
      * \code operator<< \endcode
      */
-    #define assertionNumericalEquals5(lhs,rhs,a,b,c,d,e) DILBERT_PEANO_IF_ASSERTION (!tarch::la::equals( (lhs),(rhs) )) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t == \t" << #rhs << "=" << rhs << std::endl; \
-      std::cerr << "1st argument " << #a << ": " << a << std::endl; \
-      std::cerr << "2nd argument " << #b << ": " << b << std::endl; \
-      std::cerr << "3rd argument " << #c << ": " << c << std::endl; \
-      std::cerr << "4th argument " << #d << ": " << d << std::endl; \
-      std::cerr << "5th argument " << #e << ": " << e << std::endl; \
-      assertionTriggersExit; \
+    #define assertionNumericalEquals5(lhs,rhs,a,b,c,d,e) DILBERT_PEANO_IF_ASSERTION (::dilbert::assertions::findNumericalDifference((lhs),(rhs)).index>=0) { \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t == \t",rhs), \
+        DILBERT_ASSERTION_DIFFERENCE(lhs,rhs), \
+        DILBERT_ASSERTION_PARAMETER("1st argument",a), \
+        DILBERT_ASSERTION_PARAMETER("2nd argument",b), \
+        DILBERT_ASSERTION_PARAMETER("3rd argument",c), \
+        DILBERT_ASSERTION_PARAMETER("4th argument",d), \
+        DILBERT_ASSERTION_PARAMETER("5th argument",e)); \
     }
 
     /**
      * @see ASSERTION_EXIT_CODE
      *
      * Argument lhs and rhs have to be equal besides the machine precision.
-     * Otherwise assertion will fail. The machine precision is evaluated via
-     * equals().
+     * Otherwise assertion will fail. The tolerance is set via
+     * DILBERT_ASSERT_TOLERANCE (see findNumericalDifference()), and lhs and
+     * rhs may also be whole vectors or matrices.
      *
      * If the assertion fails, the additional parameters
      * are plotted to the command line. The parameters thus have to provide
      * \code operator<< \endcode
      */
-    #define assertionNumericalEquals6(lhs,rhs,a,b,c,d,e,f) DILBERT_PEANO_IF_ASSERTION (!tarch::la::equals( (lhs),(rhs) )) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t == \t" << #rhs << "=" << rhs << std::endl; \
-      std::cerr << "1st argument " << #a << ": " << a << std::endl; \
-      std::cerr << "2nd argument " << #b << ": " << b << std::endl; \
-      std::cerr << "3rd argument " << #c << ": " << c << std::endl; \
-      std::cerr << "4th argument " << #d << ": " << d << std::endl; \
-      std::cerr << "5th argument " << #e << ": " << e << std::endl; \
-      std::cerr << "6th argument " << #f << ": " << f << std::endl; \
-      assertionTriggersExit; \
+    #define assertionNumericalEquals6(lhs,rhs,a,b,c,d,e,f) DILBERT_PEANO_IF_ASSERTION (::dilbert::assertions::findNumericalDifference((lhs),(rhs)).index>=0) { \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t == \t",rhs), \
+        DILBERT_ASSERTION_DIFFERENCE(lhs,rhs), \
+        DILBERT_ASSERTION_PARAMETER("1st argument",a), \
+        DILBERT_ASSERTION_PARAMETER("2nd argument",b), \
+        DILBERT_ASSERTION_PARAMETER("3rd argument",c), \
+        DILBERT_ASSERTION_PARAMETER("4th argument",d), \
+        DILBERT_ASSERTION_PARAMETER("5th argument",e), \
+        DILBERT_ASSERTION_PARAMETER("6th argument",f)); \
     }
 
     /**
      * @see ASSERTION_EXIT_CODE
      *
      * Argument lhs and rhs have to be equal besides the machine precision.
-     * Otherwise assertion will fail. The machine precision is evaluated via
-     * equals().
+     * Otherwise assertion will fail. The tolerance is set via
+     * DILBERT_ASSERT_TOLERANCE (see findNumericalDifference()), and lhs and
+     * rhs may also be whole vectors or matrices.
      *
      * If the assertion fails, the additional parameters
      * are plotted to the command line. The parameters thus have to provide
      * \code operator<< \endcode
      */
-    #define assertionNumericalEquals7(lhs,rhs,a,b,c,d,e,f,g) DILBERT_PEANO_IF_ASSERTION (!tarch::la::equals( (lhs),(rhs) )) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t == \t" << #rhs << "=" << rhs << std::endl; \
-      std::cerr << "1st argument " << #a << ": " << a << std::endl; \
-      std::cerr << "2nd argument " << #b << ": " << b << std::endl; \
-      std::cerr << "3rd argument " << #c << ": " << c << std::endl; \
-      std::cerr << "4th argument " << #d << ": " << d << std::endl; \
-      std::cerr << "5th argument " << #e << ": " << e << std::endl; \
-      std::cerr << "6th argument " << #f << ": " << f << std::endl; \
-      std::cerr << "7th argument " << #g << ": " << g << std::endl; \
-      assertionTriggersExit; \
+    #define assertionNumericalEquals7(lhs,rhs,a,b,c,d,e,f,g) DILBERT_PEANO_IF_ASSERTION (::dilbert::assertions::findNumericalDifference((lhs),(rhs)).index>=0) { \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t == \t",rhs), \
+        DILBERT_ASSERTION_DIFFERENCE(lhs,rhs), \
+        DILBERT_ASSERTION_PARAMETER("1st argument",a), \
+        DILBERT_ASSERTION_PARAMETER("2nd argument",b), \
+        DILBERT_ASSERTION_PARAMETER("3rd argument",c), \
+        DILBERT_ASSERTION_PARAMETER("4th argument",d), \
+        DILBERT_ASSERTION_PARAMETER("5th argument",e), \
+        DILBERT_ASSERTION_PARAMETER("6th argument",f), \
+        DILBERT_ASSERTION_PARAMETER("7th argument",g)); \
     }
 
     /**
      * @see ASSERTION_EXIT_CODE
      *
      * Argument lhs and rhs have to be equal besides the machine precision.
-     * Otherwise assertion will fail. The machine precision is evaluated via
-     * equals().
+     * Otherwise assertion will fail. The tolerance is set via
+     * DILBERT_ASSERT_TOLERANCE (see findNumericalDifference()), and lhs and
+     * rhs may also be whole vectors or matrices.
      *
      * If the assertion fails, the additional parameters
      * are plotted to the command line. The parameters thus have to provide
      * \code operator<< \endcode
      */
-    #define assertionNumericalEquals8(lhs,rhs,a,b,c,d,e,f,g,h) DILBERT_PEANO_IF_ASSERTION (!tarch::la::equals( (lhs),(rhs) )) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t == \t" << #rhs << "=" << rhs << std::endl; \
-      std::cerr << "1st argument " << #a << ": " << a << std::endl; \
-      std::cerr << "2nd argument " << #b << ": " << b << std::endl; \
-      std::cerr << "3rd argument " << #c << ": " << c << std::endl; \
-      std::cerr << "4th argument " << #d << ": " << d << std::endl; \
-      std::cerr << "5th argument " << #e << ": " << e << std::endl; \
-      std::cerr << "6th argument " << #f << ": " << f << std::endl; \
-      std::cerr << "7th argument " << #g << ": " << g << std::endl; \
-      std::cerr << "8th argument " << #h << ": " << h << std::endl; \
-      assertionTriggersExit; \
+    #define assertionNumericalEquals8(lhs,rhs,a,b,c,d,e,f,g,h) DILBERT_PEANO_IF_ASSERTION (::dilbert::assertions::findNumericalDifference((lhs),(rhs)).index>=0) { \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t == \t",rhs), \
+        DILBERT_ASSERTION_DIFFERENCE(lhs,rhs), \
+        DILBERT_ASSERTION_PARAMETER("1st argument",a), \
+        DILBERT_ASSERTION_PARAMETER("2nd argument",b), \
+        DILBERT_ASSERTION_PARAMETER("3rd argument",c), \
+        DILBERT_ASSERTION_PARAMETER("4th argument",d), \
+        DILBERT_ASSERTION_PARAMETER("5th argument",e), \
+        DILBERT_ASSERTION_PARAMETER("6th argument",f), \
+        DILBERT_ASSERTION_PARAMETER("7th argument",g), \
+        DILBERT_ASSERTION_PARAMETER("8th argument",h)); \
     }
 
     /**
      * @see ASSERTION_EXIT_CODE
      *
      * Argument lhs and rhs have to be equal besides the machine precision.
-     * Otherwise assertion will fail. The machine precision is evaluated via
-     * equals().
+     * Otherwise assertion will fail. The tolerance is set via
+     * DILBERT_ASSERT_TOLERANCE (see findNumericalDifference()), and lhs and
+     * rhs may also be whole vectors or matrices.
      *
      * If the assertion fails, the additional parameters
      * are plotted to the command line. The parameters thus have to provide
      * \code operator<< \endcode
      */
-    #define assertionNumericalEquals9(lhs,rhs,a,b,c,d,e,f,g,h,i) DILBERT_PEANO_IF_ASSERTION (!tarch::la::equals( (lhs),(rhs) )) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t == \t" << #rhs << "=" << rhs << std::endl; \
-      std::cerr << "1st argument " << #a << ": " << a << std::endl; \
-      std::cerr << "2nd argument " << #b << ": " << b << std::endl; \
-      std::cerr << "3rd argument " << #c << ": " << c << std::endl; \
-      std::cerr << "4th argument " << #d << ": " << d << std::endl; \
-      std::cerr << "5th argument " << #e << ": " << e << std::endl; \
-      std::cerr << "6th argument " << #f << ": " << f << std::endl; \
-      std::cerr << "7th argument " << #g << ": " << g << std::endl; \
-      std::cerr << "8th argument " << #h << ": " << h << std::endl; \
-      std::cerr << "9th argument " << #i << ": " << i << std::endl; \
-      assertionTriggersExit; \
+    #define assertionNumericalEquals9(lhs,rhs,a,b,c,d,e,f,g,h,i) DILBERT_PEANO_IF_ASSERTION (::dilbert::assertions::findNumericalDifference((lhs),(rhs)).index>=0) { \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t == \t",rhs), \
+        DILBERT_ASSERTION_DIFFERENCE(lhs,rhs), \
+        DILBERT_ASSERTION_PARAMETER("1st argument",a), \
+        DILBERT_ASSERTION_PARAMETER("2nd argument",b), \
+        DILBERT_ASSERTION_PARAMETER("3rd argument",c), \
+        DILBERT_ASSERTION_PARAMETER("4th argument",d), \
+        DILBERT_ASSERTION_PARAMETER("5th argument",e), \
+        DILBERT_ASSERTION_PARAMETER("6th argument",f), \
+        DILBERT_ASSERTION_PARAMETER("7th argument",g), \
+        DILBERT_ASSERTION_PARAMETER("8th argument",h), \
+        DILBERT_ASSERTION_PARAMETER("9th argument",i)); \
     }
 
     /**
      * @see ASSERTION_EXIT_CODE
      *
      * Argument lhs and rhs have to be equal besides the machine precision.
-     * Otherwise assertion will fail. The machine precision is evaluated via
-     * equals().
+     * Otherwise assertion will fail. The tolerance is set via
+     * DILBERT_ASSERT_TOLERANCE (see findNumericalDifference()), and lhs and
+     * rhs may also be whole vectors or matrices.
      *
      * If the assertion fails, the additional parameters
      * are plotted to the command line. The parameters thus have to provide
      * \code operator<< \endcode
      */
-    #define assertionNumericalEquals10(lhs,rhs,a,b,c,d,e,f,g,h,i,j) DILBERT_PEANO_IF_ASSERTION (!tarch::la::equals( (lhs),(rhs) )) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t == \t" << #rhs << "=" << rhs << std::endl; \
-      std::cerr << "1st argument " << #a << ": " << a << std::endl; \
-      std::cerr << "2nd argument " << #b << ": " << b << std::endl; \
-      std::cerr << "3rd argument " << #c << ": " << c << std::endl; \
-      std::cerr << "4th argument " << #d << ": " << d << std::endl; \
-      std::cerr << "5th argument " << #e << ": " << e << std::endl; \
-      std::cerr << "6th argument " << #f << ": " << f << std::endl; \
-      std::cerr << "7th argument " << #g << ": " << g << std::endl; \
-      std::cerr << "8th argument " << #h << ": " << h << std::endl; \
-      std::cerr << "9th argument " << #i << ": " << i << std::endl; \
-      std::cerr << "10th argument " << #j << ": " << j << std::endl; \
-      assertionTriggersExit; \
-    }
-
-    #define assertionNumericalEquals11(lhs,rhs,a,b,c,d,e,f,g,h,i,j,k) DILBERT_PEANO_IF_ASSERTION (!tarch::la::equals( (lhs),(rhs) )) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t == \t" << #rhs << "=" << rhs << std::endl; \
-      std::cerr << "1st argument " << #a << ": " << a << std::endl; \
-      std::cerr << "2nd argument " << #b << ": " << b << std::endl; \
-      std::cerr << "3rd argument " << #c << ": " << c << std::endl; \
-      std::cerr << "4th argument " << #d << ": " << d << std::endl; \
-      std::cerr << "5th argument " << #e << ": " << e << std::endl; \
-      std::cerr << "6th argument " << #f << ": " << f << std::endl; \
-      std::cerr << "7th argument " << #g << ": " << g << std::endl; \
-      std::cerr << "8th argument " << #h << ": " << h << std::endl; \
-      std::cerr << "9th argument " << #i << ": " << i << std::endl; \
-      std::cerr << "10th argument " << #j << ": " << j << std::endl; \
-      std::cerr << "11th argument " << #k << ": " << k << std::endl; \
-      assertionTriggersExit; \
-    }
-
-    #define assertionNumericalEquals12(lhs,rhs,a,b,c,d,e,f,g,h,i,j,k,l) DILBERT_PEANO_IF_ASSERTION (!tarch::la::equals( (lhs),(rhs) )) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t == \t" << #rhs << "=" << rhs << std::endl; \
-      std::cerr << "1st argument " << #a << ": " << a << std::endl; \
-      std::cerr << "2nd argument " << #b << ": " << b << std::endl; \
-      std::cerr << "3rd argument " << #c << ": " << c << std::endl; \
-      std::cerr << "4th argument " << #d << ": " << d << std::endl; \
-      std::cerr << "5th argument " << #e << ": " << e << std::endl; \
-      std::cerr << "6th argument " << #f << ": " << f << std::endl; \
-      std::cerr << "7th argument " << #g << ": " << g << std::endl; \
-      std::cerr << "8th argument " << #h << ": " << h << std::endl; \
-      std::cerr << "9th argument " << #i << ": " << i << std::endl; \
-      std::cerr << "10th argument " << #j << ": " << j << std::endl; \
-      std::cerr << "11th argument " << #k << ": " << k << std::endl; \
-      std::cerr << "12th argument " << #l << ": " << l << std::endl; \
-      assertionTriggersExit; \
-    }
-
-    #define assertionNumericalEquals13(lhs,rhs,a,b,c,d,e,f,g,h,i,j,k,l,m) DILBERT_PEANO_IF_ASSERTION (!tarch::la::equals( (lhs),(rhs) )) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t == \t" << #rhs << "=" << rhs << std::endl; \
-      std::cerr << "1st argument " << #a << ": " << a << std::endl; \
-      std::cerr << "2nd argument " << #b << ": " << b << std::endl; \
-      std::cerr << "3rd argument " << #c << ": " << c << std::endl; \
-      std::cerr << "4th argument " << #d << ": " << d << std::endl; \
-      std::cerr << "5th argument " << #e << ": " << e << std::endl; \
-      std::cerr << "6th argument " << #f << ": " << f << std::endl; \
-      std::cerr << "7th argument " << #g << ": " << g << std::endl; \
-      std::cerr << "8th argument " << #h << ": " << h << std::endl; \
-      std::cerr << "9th argument " << #i << ": " << i << std::endl; \
-      std::cerr << "10th argument " << #j << ": " << j << std::endl; \
-      std::cerr << "11th argument " << #k << ": " << k << std::endl; \
-      std::cerr << "12th argument " << #l << ": " << l << std::endl; \
-      std::cerr << "13th argument " << #m << ": " << m << std::endl; \
-      assertionTriggersExit; \
-    }
-
-    #define assertionNumericalEquals14(lhs,rhs,a,b,c,d,e,f,g,h,i,j,k,l,m,n) DILBERT_PEANO_IF_ASSERTION (!tarch::la::equals( (lhs),(rhs) )) { \
-      setAssertionOutputFormat; \
-      std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #lhs << "==" #rhs << std::endl << #lhs << "=" << lhs << "\t == \t" << #rhs << "=" << rhs << std::endl; \
-      std::cerr << "1st argument " << #a << ": " << a << std::endl; \
-      std::cerr << "2nd argument " << #b << ": " << b << std::endl; \
-      std::cerr << "3rd argument " << #c << ": " << c << std::endl; \
-      std::cerr << "4th argument " << #d << ": " << d << std::endl; \
-      std::cerr << "5th argument " << #e << ": " << e << std::endl; \
-      std::cerr << "6th argument " << #f << ": " << f << std::endl; \
-      std::cerr << "7th argument " << #g << ": " << g << std::endl; \
-      std::cerr << "8th argument " << #h << ": " << h << std::endl; \
-      std::cerr << "9th argument " << #i << ": " << i << std::endl; \
-      std::cerr << "10th argument " << #j << ": " << j << std::endl; \
-      std::cerr << "11th argument " << #k << ": " << k << std::endl; \
-      std::cerr << "12th argument " << #l << ": " << l << std::endl; \
-      std::cerr << "13th argument " << #m << ": " << m << std::endl; \
-      std::cerr << "14th argument " << #n << ": " << n << std::endl; \
-      assertionTriggersExit; \
-    }
-
-    /**
-     * @see ASSERTION_EXIT_CODE
-     *
-     * Argument lhs and rhs have to be of type Vector. Their entries have to be
-     * equal besides the machine precision.
-     * Otherwise assertion will fail. The machine precision is evaluated via
-     * equals().
-     */
-    #define assertionVectorNumericalEquals(lhs,rhs) for (int d=0; d<DIMENSIONS; d++) { assertionNumericalEquals1(lhs(d),rhs(d),d); }
-    #define assertionVectorNumericalEquals1(lhs,rhs,param0) for (int d=0; d<DIMENSIONS; d++) { assertionNumericalEquals2(lhs(d),rhs(d),d,param0); }
-    #define assertionVectorNumericalEquals2(lhs,rhs,param0,param1) for (int d=0; d<DIMENSIONS; d++) { assertionNumericalEquals3(lhs(d),rhs(d),d,param0,param1); }
-    #define assertionVectorNumericalEquals3(lhs,rhs,param0,param1,param2) for (int d=0; d<DIMENSIONS; d++) { assertionNumericalEquals4(lhs(d),rhs(d),d,param0,param1,param2); }
-    #define assertionVectorNumericalEquals4(lhs,rhs,param0,param1,param2,param3) for (int d=0; d<DIMENSIONS; d++) { assertionNumericalEquals5(lhs(d),rhs(d),d,param0,param1,param2,param3); }
-    #define assertionVectorNumericalEquals5(lhs,rhs,param0,param1,param2,param3,param4) for (int d=0; d<DIMENSIONS; d++) { assertionNumericalEquals6(lhs(d),rhs(d),d,param0,param1,param2,param3,param4); }
-    #define assertionVectorNumericalEquals6(lhs,rhs,param0,param1,param2,param3,param4,param5) for (int d=0; d<DIMENSIONS; d++) { assertionNumericalEquals7(lhs(d),rhs(d),d,param0,param1,param2,param3,param4,param5); }
-    #define assertionVectorNumericalEquals7(lhs,rhs,param0,param1,param2,param3,param4,param5,param6) for (int d=0; d<DIMENSIONS; d++) { assertionNumericalEquals8(lhs(d),rhs(d),d,param0,param1,param2,param3,param4,param5,param6); }
-    #define assertionVectorNumericalEquals8(lhs,rhs,param0,param1,param2,param3,param4,param5,param6,param7) for (int d=0; d<DIMENSIONS; d++) { assertionNumericalEquals9(lhs(d),rhs(d),d,param0,param1,param2,param3,param4,param5,param6,param7); }
-    #define assertionVectorNumericalEquals9(lhs,rhs,param0,param1,param2,param3,param4,param5,param6,param7,param8) for (int d=0; d<DIMENSIONS; d++) { assertionNumericalEquals10(lhs(d),rhs(d),d,param0,param1,param2,param3,param4,param5,param6,param7,param8); }
+    #define assertionNumericalEquals10(lhs,rhs,a,b,c,d,e,f,g,h,i,j) DILBERT_PEANO_IF_ASSERTION (::dilbert::assertions::findNumericalDifference((lhs),(rhs)).index>=0) { \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t == \t",rhs), \
+        DILBERT_ASSERTION_DIFFERENCE(lhs,rhs), \
+        DILBERT_ASSERTION_PARAMETER("1st argument",a), \
+        DILBERT_ASSERTION_PARAMETER("2nd argument",b), \
+        DILBERT_ASSERTION_PARAMETER("3rd argument",c), \
+        DILBERT_ASSERTION_PARAMETER("4th argument",d), \
+        DILBERT_ASSERTION_PARAMETER("5th argument",e), \
+        DILBERT_ASSERTION_PARAMETER("6th argument",f), \
+        DILBERT_ASSERTION_PARAMETER("7th argument",g), \
+        DILBERT_ASSERTION_PARAMETER("8th argument",h), \
+        DILBERT_ASSERTION_PARAMETER("9th argument",i), \
+        DILBERT_ASSERTION_PARAMETER("10th argument",j)); \
+    }
+
+    #define assertionNumericalEquals11(lhs,rhs,a,b,c,d,e,f,g,h,i,j,k) DILBERT_PEANO_IF_ASSERTION (::dilbert::assertions::findNumericalDifference((lhs),(rhs)).index>=0) { \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t == \t",rhs), \
+        DILBERT_ASSERTION_DIFFERENCE(lhs,rhs), \
+        DILBERT_ASSERTION_PARAMETER("1st argument",a), \
+        DILBERT_ASSERTION_PARAMETER("2nd argument",b), \
+        DILBERT_ASSERTION_PARAMETER("3rd argument",c), \
+        DILBERT_ASSERTION_PARAMETER("4th argument",d), \
+        DILBERT_ASSERTION_PARAMETER("5th argument",e), \
+        DILBERT_ASSERTION_PARAMETER("6th argument",f), \
+        DILBERT_ASSERTION_PARAMETER("7th argument",g), \
+        DILBERT_ASSERTION_PARAMETER("8th argument",h), \
+        DILBERT_ASSERTION_PARAMETER("9th argument",i), \
+        DILBERT_ASSERTION_PARAMETER("10th argument",j), \
+        DILBERT_ASSERTION_PARAMETER("11th argument",k)); \
+    }
+
+    #define assertionNumericalEquals12(lhs,rhs,a,b,c,d,e,f,g,h,i,j,k,l) DILBERT_PEANO_IF_ASSERTION (::dilbert::assertions::findNumericalDifference((lhs),(rhs)).index>=0) { \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t == \t",rhs), \
+        DILBERT_ASSERTION_DIFFERENCE(lhs,rhs), \
+        DILBERT_ASSERTION_PARAMETER("1st argument",a), \
+        DILBERT_ASSERTION_PARAMETER("2nd argument",b), \
+        DILBERT_ASSERTION_PARAMETER("3rd argument",c), \
+        DILBERT_ASSERTION_PARAMETER("4th argument",d), \
+        DILBERT_ASSERTION_PARAMETER("5th argument",e), \
+        DILBERT_ASSERTION_PARAMETER("6th argument",f), \
+        DILBERT_ASSERTION_PARAMETER("7th argument",g), \
+        DILBERT_ASSERTION_PARAMETER("8th argument",h), \
+        DILBERT_ASSERTION_PARAMETER("9th argument",i), \
+        DILBERT_ASSERTION_PARAMETER("10th argument",j), \
+        DILBERT_ASSERTION_PARAMETER("11th argument",k), \
+        DILBERT_ASSERTION_PARAMETER("12th argument",l)); \
+    }
+
+    #define assertionNumericalEquals13(lhs,rhs,a,b,c,d,e,f,g,h,i,j,k,l,m) DILBERT_PEANO_IF_ASSERTION (::dilbert::assertions::findNumericalDifference((lhs),(rhs)).index>=0) { \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t == \t",rhs), \
+        DILBERT_ASSERTION_DIFFERENCE(lhs,rhs), \
+        DILBERT_ASSERTION_PARAMETER("1st argument",a), \
+        DILBERT_ASSERTION_PARAMETER("2nd argument",b), \
+        DILBERT_ASSERTION_PARAMETER("3rd argument",c), \
+        DILBERT_ASSERTION_PARAMETER("4th argument",d), \
+        DILBERT_ASSERTION_PARAMETER("5th argument",e), \
+        DILBERT_ASSERTION_PARAMETER("6th argument",f), \
+        DILBERT_ASSERTION_PARAMETER("7th argument",g), \
+        DILBERT_ASSERTION_PARAMETER("8th argument",h), \
+        DILBERT_ASSERTION_PARAMETER("9th argument",i), \
+        DILBERT_ASSERTION_PARAMETER("10th argument",j), \
+        DILBERT_ASSERTION_PARAMETER("11th argument",k), \
+        DILBERT_ASSERTION_PARAMETER("12th argument",l), \
+        DILBERT_ASSERTION_PARAMETER("13th argument",m)); \
+    }
+
+    #define assertionNumericalEquals14(lhs,rhs,a,b,c,d,e,f,g,h,i,j,k,l,m,n) DILBERT_PEANO_IF_ASSERTION (::dilbert::assertions::findNumericalDifference((lhs),(rhs)).index>=0) { \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+        DILBERT_ASSERTION_COMPARISON(lhs,"\t == \t",rhs), \
+        DILBERT_ASSERTION_DIFFERENCE(lhs,rhs), \
+        DILBERT_ASSERTION_PARAMETER("1st argument",a), \
+        DILBERT_ASSERTION_PARAMETER("2nd argument",b), \
+        DILBERT_ASSERTION_PARAMETER("3rd argument",c), \
+        DILBERT_ASSERTION_PARAMETER("4th argument",d), \
+        DILBERT_ASSERTION_PARAMETER("5th argument",e), \
+        DILBERT_ASSERTION_PARAMETER("6th argument",f), \
+        DILBERT_ASSERTION_PARAMETER("7th argument",g), \
+        DILBERT_ASSERTION_PARAMETER("8th argument",h), \
+        DILBERT_ASSERTION_PARAMETER("9th argument",i), \
+        DILBERT_ASSERTION_PARAMETER("10th argument",j), \
+        DILBERT_ASSERTION_PARAMETER("11th argument",k), \
+        DILBERT_ASSERTION_PARAMETER("12th argument",l), \
+        DILBERT_ASSERTION_PARAMETER("13th argument",m), \
+        DILBERT_ASSERTION_PARAMETER("14th argument",n)); \
+    }
+
+    /**
+     * @see ASSERTION_EXIT_CODE
+     *
+     * Argument lhs and rhs have to be of type Vector. Their first DIMENSIONS
+     * entries have to be equal besides the machine precision. Otherwise
+     * assertion will fail. All entries are compared in one pass with the
+     * tolerance of assertionNumericalEquals(), and the first differing one is
+     * reported. The vector assertions are classified as expensive.
+     */
+    #define assertionVectorNumericalEquals(lhs,rhs) { \
+      DILBERT_ASSERTION_COST(::dilbert::assertions::Expensive); \
+      DILBERT_PEANO_IF_ASSERTION (::dilbert::assertions::findComponentDifference<DIMENSIONS>((lhs),(rhs)).index>=0) { \
+        ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+          DILBERT_ASSERTION_COMPARISON(lhs,"\t == \t",rhs), \
+          DILBERT_ASSERTION_COMPONENT_DIFFERENCE(lhs,rhs)); \
+      } \
+    }
+
+    #define assertionVectorNumericalEquals1(lhs,rhs,param0) { \
+      DILBERT_ASSERTION_COST(::dilbert::assertions::Expensive); \
+      DILBERT_PEANO_IF_ASSERTION (::dilbert::assertions::findComponentDifference<DIMENSIONS>((lhs),(rhs)).index>=0) { \
+        ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+          DILBERT_ASSERTION_COMPARISON(lhs,"\t == \t",rhs), \
+          DILBERT_ASSERTION_COMPONENT_DIFFERENCE(lhs,rhs), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param0)); \
+      } \
+    }
+
+    #define assertionVectorNumericalEquals2(lhs,rhs,param0,param1) { \
+      DILBERT_ASSERTION_COST(::dilbert::assertions::Expensive); \
+      DILBERT_PEANO_IF_ASSERTION (::dilbert::assertions::findComponentDifference<DIMENSIONS>((lhs),(rhs)).index>=0) { \
+        ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+          DILBERT_ASSERTION_COMPARISON(lhs,"\t == \t",rhs), \
+          DILBERT_ASSERTION_COMPONENT_DIFFERENCE(lhs,rhs), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param0), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param1)); \
+      } \
+    }
+
+    #define assertionVectorNumericalEquals3(lhs,rhs,param0,param1,param2) { \
+      DILBERT_ASSERTION_COST(::dilbert::assertions::Expensive); \
+      DILBERT_PEANO_IF_ASSERTION (::dilbert::assertions::findComponentDifference<DIMENSIONS>((lhs),(rhs)).index>=0) { \
+        ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+          DILBERT_ASSERTION_COMPARISON(lhs,"\t == \t",rhs), \
+          DILBERT_ASSERTION_COMPONENT_DIFFERENCE(lhs,rhs), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param0), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param1), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param2)); \
+      } \
+    }
+
+    #define assertionVectorNumericalEquals4(lhs,rhs,param0,param1,param2,param3) { \
+      DILBERT_ASSERTION_COST(::dilbert::assertions::Expensive); \
+      DILBERT_PEANO_IF_ASSERTION (::dilbert::assertions::findComponentDifference<DIMENSIONS>((lhs),(rhs)).index>=0) { \
+        ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+          DILBERT_ASSERTION_COMPARISON(lhs,"\t == \t",rhs), \
+          DILBERT_ASSERTION_COMPONENT_DIFFERENCE(lhs,rhs), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param0), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param1), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param2), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param3)); \
+      } \
+    }
+
+    #define assertionVectorNumericalEquals5(lhs,rhs,param0,param1,param2,param3,param4) { \
+      DILBERT_ASSERTION_COST(::dilbert::assertions::Expensive); \
+      DILBERT_PEANO_IF_ASSERTION (::dilbert::assertions::findComponentDifference<DIMENSIONS>((lhs),(rhs)).index>=0) { \
+        ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+          DILBERT_ASSERTION_COMPARISON(lhs,"\t == \t",rhs), \
+          DILBERT_ASSERTION_COMPONENT_DIFFERENCE(lhs,rhs), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param0), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param1), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param2), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param3), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param4)); \
+      } \
+    }
+
+    #define assertionVectorNumericalEquals6(lhs,rhs,param0,param1,param2,param3,param4,param5) { \
+      DILBERT_ASSERTION_COST(::dilbert::assertions::Expensive); \
+      DILBERT_PEANO_IF_ASSERTION (::dilbert::assertions::findComponentDifference<DIMENSIONS>((lhs),(rhs)).index>=0) { \
+        ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+          DILBERT_ASSERTION_COMPARISON(lhs,"\t == \t",rhs), \
+          DILBERT_ASSERTION_COMPONENT_DIFFERENCE(lhs,rhs), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param0), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param1), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param2), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param3), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param4), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param5)); \
+      } \
+    }
+
+    #define assertionVectorNumericalEquals7(lhs,rhs,param0,param1,param2,param3,param4,param5,param6) { \
+      DILBERT_ASSERTION_COST(::dilbert::assertions::Expensive); \
+      DILBERT_PEANO_IF_ASSERTION (::dilbert::assertions::findComponentDifference<DIMENSIONS>((lhs),(rhs)).index>=0) { \
+        ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+          DILBERT_ASSERTION_COMPARISON(lhs,"\t == \t",rhs), \
+          DILBERT_ASSERTION_COMPONENT_DIFFERENCE(lhs,rhs), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param0), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param1), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param2), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param3), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param4), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param5), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param6)); \
+      } \
+    }
+
+    #define assertionVectorNumericalEquals8(lhs,rhs,param0,param1,param2,param3,param4,param5,param6,param7) { \
+      DILBERT_ASSERTION_COST(::dilbert::assertions::Expensive); \
+      DILBERT_PEANO_IF_ASSERTION (::dilbert::assertions::findComponentDifference<DIMENSIONS>((lhs),(rhs)).index>=0) { \
+        ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+          DILBERT_ASSERTION_COMPARISON(lhs,"\t == \t",rhs), \
+          DILBERT_ASSERTION_COMPONENT_DIFFERENCE(lhs,rhs), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param0), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param1), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param2), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param3), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param4), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param5), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param6), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param7)); \
+      } \
+    }
+
+    #define assertionVectorNumericalEquals9(lhs,rhs,param0,param1,param2,param3,param4,param5,param6,param7,param8) { \
+      DILBERT_ASSERTION_COST(::dilbert::assertions::Expensive); \
+      DILBERT_PEANO_IF_ASSERTION (::dilbert::assertions::findComponentDifference<DIMENSIONS>((lhs),(rhs)).index>=0) { \
+        ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #lhs "==" #rhs, \
+          DILBERT_ASSERTION_COMPARISON(lhs,"\t == \t",rhs), \
+          DILBERT_ASSERTION_COMPONENT_DIFFERENCE(lhs,rhs), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param0), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param1), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param2), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param3), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param4), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param5), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param6), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param7), \
+          DILBERT_ASSERTION_PARAMETER("parameter",param8)); \
+      } \
+    }
+
 
     /**
      * @see ASSERTION_EXIT_CODE
@@ -969,19 +2292,86 @@
      * the terminal. Thus, message should have type string or char.
      */
     #define assertionMsg(expr,message) DILBERT_PEANO_IF_ASSERTION (!(expr)) { \
-      setAssertionOutputFormat; std::cerr << "assertion in file " << __FILE__ << ", line " << __LINE__ << " failed: " << #expr << std::endl << message << std::endl ; \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFailure(__FILE__, __LINE__, #expr, \
+        DILBERT_ASSERTION_MESSAGE(message)); \
     }
 
+    /**
+     * @see ASSERTION_EXIT_CODE
+     *
+     * Equals assertion() but classifies the check with a different cost.
+     * Cheap assertions can be kept on in production runs via
+     * DILBERT_ASSERT_LEVEL=cheap.
+     */
+    #define assertionCheap(expr)     { DILBERT_ASSERTION_COST(::dilbert::assertions::Cheap);     assertion(expr); }
+    #define assertionExpensive(expr) { DILBERT_ASSERTION_COST(::dilbert::assertions::Expensive); assertion(expr); }
+    #define assertionParanoid(expr)  { DILBERT_ASSERTION_COST(::dilbert::assertions::Paranoid);  assertion(expr); }
+
+    /**
+     * @see ASSERTION_EXIT_CODE
+     *
+     * Bulk assertions on whole arrays of doubles, e.g. the patch data of a
+     * solver: All n entries have to be finite, lie within [lower,upper] or
+     * equal those of the other array up to the tolerance. They run vectorised
+     * (see dilbert::assertions::findNonFinite()) and report the first failing
+     * index. They are never turned into assumptions (as the condition is a
+     * call), i.e. an unchecked kernel variant skips them altogether. Like the
+     * vector assertions, they are classified as expensive.
+     */
+    #define assertionAllFinite(data,n) { \
+      DILBERT_ASSERTION_COST(::dilbert::assertions::Expensive); \
+      int dilbertFailingIndex = -1; \
+      if (dilbert_CheckedVariant) DILBERT_PEANO_IF_ASSERTION ((dilbertFailingIndex = ::dilbert::assertions::findNonFinite(data, n))>=0) { \
+        ::dilbert::assertions::reportFailure(__FILE__, __LINE__, "allFinite(" #data "," #n ")", \
+          DILBERT_ASSERTION_MESSAGE("first failing index " << dilbertFailingIndex << ": " #data "[" << dilbertFailingIndex << "]=" << (data)[dilbertFailingIndex])); \
+      } \
+    }
+
+    #define assertionAllInRange(data,n,lower,upper) { \
+      DILBERT_ASSERTION_COST(::dilbert::assertions::Expensive); \
+      int dilbertFailingIndex = -1; \
+      if (dilbert_CheckedVariant) DILBERT_PEANO_IF_ASSERTION ((dilbertFailingIndex = ::dilbert::assertions::findOutOfRange(data, n, lower, upper))>=0) { \
+        ::dilbert::assertions::reportFailure(__FILE__, __LINE__, "allInRange(" #data "," #n "," #lower "," #upper ")", \
+          DILBERT_ASSERTION_MESSAGE("first failing index " << dilbertFailingIndex << ": " #data "[" << dilbertFailingIndex << "]=" << (data)[dilbertFailingIndex]), \
+          DILBERT_ASSERTION_PARAMETER("parameter", lower), \
+          DILBERT_ASSERTION_PARAMETER("parameter", upper)); \
+      } \
+    }
+
+    #define assertionArraysNumericallyEqual(lhs,rhs,n,tolerance) { \
+      DILBERT_ASSERTION_COST(::dilbert::assertions::Expensive); \
+      int dilbertFailingIndex = -1; \
+      if (dilbert_CheckedVariant) DILBERT_PEANO_IF_ASSERTION ((dilbertFailingIndex = ::dilbert::assertions::findNumericalDifference(lhs, rhs, n, tolerance))>=0) { \
+        ::dilbert::assertions::reportFailure(__FILE__, __LINE__, "arraysNumericallyEqual(" #lhs "," #rhs "," #n "," #tolerance ")", \
+          DILBERT_ASSERTION_MESSAGE("first failing index " << dilbertFailingIndex << ": " \
+            #lhs "[" << dilbertFailingIndex << "]=" << (lhs)[dilbertFailingIndex] << "\t == \t" \
+            #rhs "[" << dilbertFailingIndex << "]=" << (rhs)[dilbertFailingIndex]), \
+          DILBERT_ASSERTION_PARAMETER("parameter", tolerance)); \
+      } \
+    }
+
+    /**
+     * @see ASSERTION_EXIT_CODE
+     *
+     * Collective assertion: value (any type convertible to double, such as
+     * the time step size or a cell count) has to be the same on all ranks.
+     * The check is deferred to the next traversal boundary (see
+     * dilbert::assertions::recordCollective()), where all ranks report the
+     * assertion if any two ranks disagree.
+     */
+    #define assertionAllRanksEqual(value) \
+      if (DILBERT_UNLIKELY(::dilbert::assertions::staticBranch< ::dilbert::assertions::CollectiveKey >())) { \
+        ::dilbert::assertions::recordCollective(DILBERT_ASSERTION_SITE("allRanksEqual(" #value ")"), static_cast<double>(value)); \
+      }
+
     /**
      * @see ASSERTION_EXIT_CODE
      *
      * This assertion fails always and then prints a message.
      */
     #define assertionFail(message) { \
-      setAssertionOutputFormat; std::cerr << "fail-assertion in file " << __FILE__ << ", line " << __LINE__ <<  std::endl << message << std::endl; \
-      std::cerr.flush(); \
-      assertionTriggersExit; \
+      ::dilbert::assertions::reportFail(__FILE__, __LINE__, \
+        DILBERT_ASSERTION_MESSAGE(message)); \
     }
 
 #endif /* _TARCH_ASSERTIONS_H_ */